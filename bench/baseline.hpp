@@ -0,0 +1,295 @@
+#pragma once
+/*
+Benchmark baselines: run metadata, a small JSON reader for saved bench output, and the
+noise-aware comparison behind `bench --baseline FILE`.
+
+A phase regresses when its median grows by more than all of
+    threshold * baseline median           (relative, --threshold, default 10%)
+    iqr_factor * max(baseline IQR, IQR)   (noise, 1.5 interquartile ranges)
+    min_ms                                (absolute floor, --min-ms, default 1 ms)
+Peak RSS uses the same relative threshold with a 2 MB floor. Variable and clause counts are
+deterministic, so any growth is a regression (and any shrinkage is reported).
+*/
+
+#include <map>
+#include <cmath>
+#include <ctime>
+#include <cctype>
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+#include <unistd.h>
+
+// === JSON ===
+
+struct JsonValue {
+    enum class Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = Type::NUL;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    const JsonValue& operator[](const std::string& key) const {
+        static const JsonValue null;
+        auto it = object.find(key);
+        return it == object.end() ? null : it->second;
+    }
+    bool has(const std::string& key) const { return object.count(key) > 0; }
+};
+
+class JsonParser {
+    const std::string& text;
+    size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("JSON: " + what + " at offset " + std::to_string(pos));
+    }
+
+    void skip_space() {
+        while (pos < text.size() && std::isspace((unsigned char)text[pos])) pos++;
+    }
+
+    bool consume(char c) {
+        skip_space();
+        if (pos < text.size() && text[pos] == c) { pos++; return true; }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) fail(std::string("expected '") + c + "'");
+    }
+
+    std::string parse_string() {
+        expect('"');
+        std::string out;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\' && pos < text.size()) {
+                char e = text[pos++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'u': pos += 4; out += '?'; break;  // not produced by bench
+                    default: out += e;
+                }
+            } else {
+                out += c;
+            }
+        }
+        if (pos >= text.size()) fail("unterminated string");
+        pos++;
+        return out;
+    }
+
+public:
+    explicit JsonParser(const std::string& text) : text(text) {}
+
+    JsonValue parse() {
+        JsonValue value = parse_value();
+        skip_space();
+        if (pos != text.size()) fail("trailing characters");
+        return value;
+    }
+
+    JsonValue parse_value() {
+        skip_space();
+        if (pos >= text.size()) fail("unexpected end");
+        JsonValue value;
+        char c = text[pos];
+        if (c == '{') {
+            value.type = JsonValue::Type::OBJECT;
+            pos++;
+            if (consume('}')) return value;
+            do {
+                skip_space();
+                std::string key = parse_string();
+                expect(':');
+                value.object[key] = parse_value();
+            } while (consume(','));
+            expect('}');
+        } else if (c == '[') {
+            value.type = JsonValue::Type::ARRAY;
+            pos++;
+            if (consume(']')) return value;
+            do value.array.push_back(parse_value()); while (consume(','));
+            expect(']');
+        } else if (c == '"') {
+            value.type = JsonValue::Type::STRING;
+            value.string = parse_string();
+        } else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0) {
+            value.type = JsonValue::Type::BOOL;
+            value.boolean = text[pos] == 't';
+            pos += value.boolean ? 4 : 5;
+        } else if (text.compare(pos, 4, "null") == 0) {
+            pos += 4;
+        } else {
+            value.type = JsonValue::Type::NUMBER;
+            size_t used = 0;
+            try {
+                value.number = std::stod(text.substr(pos, 32), &used);
+            } catch (const std::exception&) {
+                fail("invalid value");
+            }
+            pos += used;
+        }
+        return value;
+    }
+};
+
+inline JsonValue read_json_file(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) throw std::runtime_error("Cannot open " + filename);
+    std::stringstream ss;
+    ss << file.rdbuf();
+    return JsonParser(ss.str()).parse();
+}
+
+// === Statistics ===
+
+// Quantile q in [0, 1] with linear interpolation
+inline double quantile(std::vector<double> values, double q) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    double idx = q * (values.size() - 1);
+    size_t lo = size_t(idx);
+    size_t hi = std::min(lo + 1, values.size() - 1);
+    return values[lo] + (idx - lo) * (values[hi] - values[lo]);
+}
+
+inline double median(const std::vector<double>& values) { return quantile(values, 0.5); }
+inline double iqr(const std::vector<double>& values) { return quantile(values, 0.75) - quantile(values, 0.25); }
+
+// === Metadata ===
+
+inline std::string command_output(const char* command) {
+    std::unique_ptr<FILE, int (*)(FILE*)> pipe(popen(command, "r"), pclose);
+    if (!pipe) return "";
+    std::array<char, 256> buf;
+    std::string out;
+    while (fgets(buf.data(), buf.size(), pipe.get())) out += buf.data();
+    while (!out.empty() && std::isspace((unsigned char)out.back())) out.pop_back();
+    return out;
+}
+
+inline std::string cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+    }
+    return "unknown";
+}
+
+// Key / value pairs describing where and from what a benchmark ran
+inline std::vector<std::pair<std::string, std::string>> run_metadata() {
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    std::string commit = command_output("git rev-parse HEAD 2>/dev/null");
+    std::string dirty = commit.empty() ? "" : command_output("git status --porcelain --untracked-files=no 2>/dev/null");
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return {
+        {"commit", commit.empty() ? "unknown" : commit + (dirty.empty() ? "" : "-dirty")},
+        {"host", host},
+        {"cpu", cpu_model()},
+        {"cpus", std::to_string(sysconf(_SC_NPROCESSORS_ONLN))},
+        {"compiler", __VERSION__},
+        {"timestamp", timestamp},
+    };
+}
+
+// === Comparison ===
+
+struct CompareOptions {
+    double threshold = 0.10;   // relative median growth
+    double iqr_factor = 1.5;
+    double min_ms = 1.0;
+    double min_rss_mb = 2.0;
+};
+
+// Compare `current` against `baseline` (both parsed bench output) and print one line per
+// check. Returns the number of regressions.
+inline int compare_benchmarks(const JsonValue& baseline, const JsonValue& current,
+                              const CompareOptions& options, std::ostream& out) {
+    std::map<std::string, const JsonValue*> base_by_name;
+    for (const JsonValue& b : baseline["benchmarks"].array) base_by_name[b["name"].string] = &b;
+
+    auto samples = [](const JsonValue& phase) {
+        std::vector<double> values;
+        for (const JsonValue& v : phase["samples_ms"].array) values.push_back(v.number);
+        return values;
+    };
+    auto line = [&](const std::string& name, const std::string& what, double base, double cur,
+                    const std::string& unit, const std::string& verdict) {
+        double delta = base > 0 ? (cur - base) / base * 100 : 0;
+        int precision = unit.empty() ? 0 : 3;  // counts are integers
+        out << std::left << std::setw(22) << name << std::setw(36) << what << std::right << std::fixed
+            << std::setprecision(precision) << std::setw(12) << base << std::setw(12) << cur << " " << std::setw(3) << unit
+            << std::setprecision(1) << std::showpos << std::setw(9) << delta << "%" << std::noshowpos
+            << "  " << verdict << "\n";
+    };
+
+    out << "baseline " << baseline["metadata"]["commit"].string << " (" << baseline["metadata"]["host"].string
+        << "), current " << current["metadata"]["commit"].string << " (" << current["metadata"]["host"].string << ")\n";
+    if (baseline["metadata"]["host"].string != current["metadata"]["host"].string ||
+        baseline["metadata"]["cpu"].string != current["metadata"]["cpu"].string)
+        out << "warning: different machines, timings are not directly comparable\n";
+
+    int regressions = 0;
+    for (const JsonValue& cur : current["benchmarks"].array) {
+        const std::string& name = cur["name"].string;
+        auto it = base_by_name.find(name);
+        if (it == base_by_name.end()) {
+            out << name << ": not in baseline\n";
+            continue;
+        }
+        const JsonValue& base = *it->second;
+
+        for (const char* count : {"variables", "clauses"}) {
+            double b = base[count].number, c = cur[count].number;
+            std::string verdict = c > b ? "REGRESSION" : c < b ? "changed" : "ok";
+            if (c > b) regressions++;
+            line(name, count, b, c, "", verdict);
+        }
+
+        for (const auto& [phase, cur_phase] : cur["phases"].object) {
+            if (!base["phases"].has(phase)) continue;
+            std::vector<double> b = samples(base["phases"][phase]), c = samples(cur_phase);
+            double bm = median(b), cm = median(c);
+            double noise = options.iqr_factor * std::max(iqr(b), iqr(c));
+            double allowed = std::max({options.threshold * bm, noise, options.min_ms});
+            std::string verdict = "ok";
+            if (cm - bm > allowed) {
+                verdict = "REGRESSION";
+                regressions++;
+            } else if (bm - cm > allowed) {
+                verdict = "improved";
+            }
+            if (b.size() < 3 || c.size() < 3) verdict += " (few repeats)";
+            line(name, phase, bm, cm, "ms", verdict);
+        }
+
+        for (const auto& [phase, cur_peak] : cur["peak_rss_mb"].object) {
+            if (!base["peak_rss_mb"].has(phase)) continue;
+            double b = base["peak_rss_mb"][phase].number, c = cur_peak.number;
+            bool worse = c - b > std::max(options.threshold * b, options.min_rss_mb);
+            if (worse) regressions++;
+            line(name, "peak RSS " + phase, b, c, "MB", worse ? "REGRESSION" : "ok");
+        }
+    }
+    out << (regressions ? std::to_string(regressions) + " regression(s)\n" : "no regressions\n");
+    return regressions;
+}
@@ -0,0 +1,225 @@
+/*
+Benchmark driver: runs every scenario in scenarios.hpp several times and reports, as JSON, the
+median and interquartile range of each phase together with every sample and the problem size,
+after metadata about the run (commit, host, CPU, compiler, time):
+
+    {"metadata": {"commit": "...", "host": "...", ...},
+     "benchmarks": [{"name": "lwss", "repeats": 5, "variables": 38, "clauses": 3416,
+                     "solver_status": "SAT",
+                     "phases": {"build": {"median_ms": 0.12, "iqr_ms": 0.01, "samples_ms": [...]}, ...}}]}
+
+Saved output serves as a baseline: with --baseline FILE the run is compared against it (see
+baseline.hpp for the thresholds), a report goes to stderr, and the exit status is 1 if anything
+regressed. --current FILE compares a saved run instead of running the scenarios.
+
+Phases are read from the profiling timers of each run:
+    build   construct_variable_grid, or SearchProblem::build without its dedup pass
+    dedup   SearchProblem::build/dedup transitions (SearchProblem scenarios only)
+    encode  calculate_clauses or SearchProblem::get_clauses
+    dimacs  solve/DIMACS gen
+    solve   solve/solver
+    total   the whole scenario, including setup
+
+With --perf, each phase also gets "counters": the median hardware counters (cycles,
+instructions, cache_misses, branch_misses) where perf_event_open is available.
+
+Alongside the timings, "peak_rss_mb" gives the largest peak RSS each memory phase reached over
+the repeats (see memory_stats.hpp); built with -DCOUNT_ALLOCATIONS, "allocations" gives the
+peak live bytes of the tracked containers.
+
+Usage: bench [--repeats N] [--filter SUBSTRING] [--no-solve] [--perf] [--out FILE]
+             [--baseline FILE [--current FILE] [--threshold PERCENT] [--min-ms MS]]
+Library console output is suppressed while scenarios run.
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include "scenarios.hpp"
+#include "baseline.hpp"
+
+struct BenchResult {
+    std::string name;
+    ScenarioRun run;
+    std::map<std::string, std::vector<double>> samples_ms;  // phase -> one sample per repeat
+    std::map<std::string, std::vector<perf_counters::Sample>> hardware;  // phase -> one sample per repeat
+    std::map<std::string, double> peak_rss_mb;               // memory phase -> max over repeats
+    std::map<std::string, double> alloc_peak_mb;             // allocation tag -> max over repeats
+};
+
+double ms(int64_t ns) { return ns / 1e6; }
+
+BenchResult run_benchmark(const Scenario& scenario, int repeats, bool solve) {
+    BenchResult result;
+    result.name = scenario.name;
+    for (int i = 0; i < repeats; i++) {
+        profiling::reset();
+        profiling::enable();
+        memory_stats::enable();
+        memory_stats::clear_phase_results();
+        memory_stats::reset_allocation_counts();
+        auto start = std::chrono::steady_clock::now();
+        result.run = scenario.run(solve);
+        auto total = std::chrono::steady_clock::now() - start;
+        memory_stats::enable(false);
+        profiling::enable(false);
+
+        using profiling::timer_total_ns;
+        int64_t dedup = timer_total_ns("SearchProblem::build/dedup transitions");
+        int64_t build = timer_total_ns("construct_variable_grid") + timer_total_ns("SearchProblem::build") - dedup;
+        auto& s = result.samples_ms;
+        s["build"].push_back(ms(build));
+        s["dedup"].push_back(ms(dedup));
+        s["encode"].push_back(ms(timer_total_ns("calculate_clauses") + timer_total_ns("SearchProblem::get_clauses")));
+        s["dimacs"].push_back(ms(timer_total_ns("solve/DIMACS gen")));
+        s["solve"].push_back(ms(timer_total_ns("solve/solver")));
+        s["total"].push_back(std::chrono::duration<double, std::milli>(total).count());
+
+        using profiling::timer_counters;
+        perf_counters::Sample hw_dedup = timer_counters("SearchProblem::build/dedup transitions");
+        auto& hw = result.hardware;
+        hw["build"].push_back(timer_counters("construct_variable_grid") + timer_counters("SearchProblem::build") - hw_dedup);
+        hw["dedup"].push_back(hw_dedup);
+        hw["encode"].push_back(timer_counters("calculate_clauses") + timer_counters("SearchProblem::get_clauses"));
+        hw["dimacs"].push_back(timer_counters("solve/DIMACS gen"));
+        hw["solve"].push_back(timer_counters("solve/solver"));
+
+        for (const auto& [phase, stats] : memory_stats::phase_results()) {
+            double& peak = result.peak_rss_mb[phase];
+            peak = std::max(peak, stats.peak_rss / (1024.0 * 1024.0));
+        }
+        for (int tag = 0; tag < int(memory_stats::AllocTag::COUNT); tag++) {
+            const memory_stats::AllocCounters& c = memory_stats::alloc_counters(memory_stats::AllocTag(tag));
+            if (c.allocations == 0) continue;
+            double& peak = result.alloc_peak_mb[memory_stats::tag_name(memory_stats::AllocTag(tag))];
+            peak = std::max(peak, c.peak_bytes / (1024.0 * 1024.0));
+        }
+    }
+    profiling::reset();
+    return result;
+}
+
+// ', "counters": {...}' with the median of each counter read in every repeat, if any
+void write_counters(std::ostream& out, const std::vector<perf_counters::Sample>& samples) {
+    bool first = true;
+    for (int c = 0; c < perf_counters::NUM_COUNTERS; c++) {
+        std::vector<double> values;
+        for (const perf_counters::Sample& sample : samples)
+            if (sample.has(c)) values.push_back(double(sample.values[c]));
+        if (values.empty() || values.size() < samples.size()) continue;
+        out << (first ? ", \"counters\": {" : ", ") << "\"" << perf_counters::counter_name(c) << "\": "
+            << std::setprecision(0) << median(values) << std::setprecision(3);
+        first = false;
+    }
+    if (!first) out << "}";
+}
+
+void write_json(std::ostream& out, const std::vector<BenchResult>& results, int repeats) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"metadata\": {";
+    bool first_key = true;
+    for (const auto& [key, value] : run_metadata()) {
+        out << (first_key ? "" : ", ") << "\"" << key << "\": \"" << profiling::detail::json_escape(value) << "\"";
+        first_key = false;
+    }
+    out << "},\n \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "  {\"name\": \"" << r.name << "\", \"repeats\": " << repeats
+            << ", \"variables\": " << r.run.variables << ", \"clauses\": " << r.run.clauses
+            << ", \"solver_status\": \"" << r.run.status << "\",\n   \"phases\": {";
+        bool first = true;
+        for (const char* phase : {"build", "dedup", "encode", "dimacs", "solve", "total"}) {
+            const std::vector<double>& samples = r.samples_ms.at(phase);
+            out << (first ? "" : ",") << "\n    \"" << phase << "\": {\"median_ms\": " << median(samples)
+                << ", \"iqr_ms\": " << iqr(samples) << ", \"samples_ms\": [";
+            for (size_t k = 0; k < samples.size(); k++) out << (k ? ", " : "") << samples[k];
+            out << "]";
+            write_counters(out, r.hardware.count(phase) ? r.hardware.at(phase) : std::vector<perf_counters::Sample>{});
+            out << "}";
+            first = false;
+        }
+        out << "},\n   \"peak_rss_mb\": {";
+        first = true;
+        for (const auto& [phase, peak] : r.peak_rss_mb) {
+            out << (first ? "" : ", ") << "\"" << phase << "\": " << peak;
+            first = false;
+        }
+        out << "}";
+        if (!r.alloc_peak_mb.empty()) {
+            out << ",\n   \"allocations\": {";
+            first = true;
+            for (const auto& [tag, peak] : r.alloc_peak_mb) {
+                out << (first ? "" : ", ") << "\"" << tag << "\": {\"peak_mb\": " << peak << "}";
+                first = false;
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+}
+
+int main(int argc, char** argv) {
+    int repeats = 5;
+    bool solve = true;
+    std::string filter, out_file, baseline_file, current_file;
+    CompareOptions compare;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--repeats" && i + 1 < argc) repeats = std::max(1, std::stoi(argv[++i]));
+        else if (arg == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if (arg == "--no-solve") solve = false;
+        else if (arg == "--perf") perf_counters::enable();
+        else if (arg == "--out" && i + 1 < argc) out_file = argv[++i];
+        else if (arg == "--baseline" && i + 1 < argc) baseline_file = argv[++i];
+        else if (arg == "--current" && i + 1 < argc) current_file = argv[++i];
+        else if (arg == "--threshold" && i + 1 < argc) compare.threshold = std::stod(argv[++i]) / 100;
+        else if (arg == "--min-ms" && i + 1 < argc) compare.min_ms = std::stod(argv[++i]);
+        else {
+            std::cerr << "usage: " << argv[0] << " [--repeats N] [--filter SUBSTRING] [--no-solve] [--perf] [--out FILE]\n"
+                      << "       [--baseline FILE [--current FILE] [--threshold PERCENT] [--min-ms MS]]\n";
+            return 2;
+        }
+    }
+    if (!current_file.empty() && baseline_file.empty()) {
+        std::cerr << "bench: --current needs --baseline\n";
+        return 2;
+    }
+    if (!current_file.empty()) {
+        int regressions = compare_benchmarks(read_json_file(baseline_file), read_json_file(current_file), compare, std::cerr);
+        return regressions ? 1 : 0;
+    }
+
+    if (perf_counters::enabled() && !perf_counters::available())
+        std::cerr << "bench: hardware counters are not available, --perf has no effect" << std::endl;
+
+    // Silence the library's per-phase log lines
+    logging::set_sink(std::make_shared<logging::NullSink>());
+    std::vector<BenchResult> results;
+    for (const Scenario& scenario : all_scenarios()) {
+        if (!filter.empty() && scenario.name.find(filter) == std::string::npos) continue;
+        std::cerr << "bench: " << scenario.name << "..." << std::endl;
+        results.push_back(run_benchmark(scenario, repeats, solve));
+    }
+
+    std::ostringstream json;
+    write_json(json, results, repeats);
+    if (out_file.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream file = file_checks(out_file, true);
+        file << json.str();
+    }
+
+    if (!baseline_file.empty()) {
+        int regressions = compare_benchmarks(read_json_file(baseline_file), JsonParser(json.str()).parse(), compare, std::cerr);
+        return regressions ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,314 @@
+/*
+Microbenchmarks: the hot kernels of the encoding pipeline in isolation, each on fixed synthetic
+inputs (seeded, identical on every run), reported in nanoseconds per operation so that a change
+to one kernel can be judged without the noise of a whole search.
+
+    kernel               op           what one operation is
+    transition_clauses   transition   add_transition_clauses on one 3x3 neighborhood + output
+    clause_builder       clause       ClauseBuilder clear / add per literal / get
+    union_find           call         UnionFind<int> unite or find, as in deduplicate_transitions
+    find_all_images      point        find_all_images under the D4 symmetry group of a square box
+    signature_hash       transition   sort neighbors, SignatureHash lookup / insert (dedup pass)
+    make_dimacs_string   clause       DIMACS text for a ClauseList
+    parse_dimacs_output  literal      parse a solver's "s" / "v" output
+    life_step            cell         one bitboard generation of a 256x256 soup (plus a dead border)
+    evolve_history       generation   evolve a 64x64 soup for 100 generations (KnownPattern setup)
+
+Each sample repeats a kernel until it has run for --min-time milliseconds and divides the
+elapsed time by the operations done; the median and interquartile range over --samples samples
+are reported, after one untimed warmup call.
+
+Usage: micro [--filter SUBSTRING] [--samples N] [--min-time MS] [--json] [--out FILE]
+*/
+
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <functional>
+#include <unordered_map>
+#include "scenarios.hpp"
+#include "baseline.hpp"
+
+// Keep the compiler from discarding a result that is otherwise unused
+template <typename T>
+inline void keep(const T& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+struct Kernel {
+    std::string name;
+    std::string op;
+    std::function<size_t()> run;  // one call over the fixed inputs; returns operations done
+};
+
+struct KernelResult {
+    std::string name;
+    std::string op;
+    size_t ops_per_call = 0;
+    std::vector<double> samples_ns;  // ns per operation
+};
+
+// === Inputs ===
+
+// Transitions as add_transition_clauses sees them: mostly variables (>= 2), some known cells
+std::vector<std::array<int, 10>> make_transitions(size_t count, int num_variables, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> var(2, num_variables + 1);
+    std::uniform_real_distribution<double> u(0, 1);
+    std::vector<std::array<int, 10>> transitions(count);
+    for (auto& ten_cells : transitions)
+        for (int& cell : ten_cells) {
+            double r = u(rng);
+            cell = r < 0.15 ? 0 : r < 0.2 ? 1 : var(rng);
+        }
+    return transitions;
+}
+
+std::vector<Kernel> make_kernels() {
+    std::vector<Kernel> kernels;
+
+    auto transitions = std::make_shared<std::vector<std::array<int, 10>>>(make_transitions(4096, 2000, 1));
+
+    kernels.push_back({"transition_clauses", "transition", [transitions]() {
+        static ClauseList clauses;
+        clauses.clear();
+        ClauseBuilder clause;
+        for (const auto& ten_cells : *transitions) add_transition_clauses(ten_cells, clause, clauses);
+        keep(clauses.size());
+        return transitions->size();
+    }});
+
+    // Literal lists of 3 to 9 distinct variables with random signs; one in 16 is a tautology
+    auto literal_lists = std::make_shared<std::vector<std::vector<int>>>();
+    {
+        std::mt19937 rng(2);
+        std::uniform_int_distribution<int> length(3, MAX_CLAUSE_LEN), var(1, 5000), sign(0, 1);
+        for (int i = 0; i < 4096; i++) {
+            std::vector<int> lits;
+            int n = length(rng);
+            while (int(lits.size()) < n) {
+                int v = var(rng);
+                if (std::find(lits.begin(), lits.end(), v) == lits.end() &&
+                    std::find(lits.begin(), lits.end(), -v) == lits.end())
+                    lits.push_back(sign(rng) ? v : -v);
+            }
+            if (i % 16 == 0) lits.back() = -lits.front();
+            literal_lists->push_back(lits);
+        }
+    }
+
+    kernels.push_back({"clause_builder", "clause", [literal_lists]() {
+        ClauseBuilder clause;
+        int sum = 0;
+        for (const auto& lits : *literal_lists) {
+            clause.clear();
+            for (int lit : lits)
+                if (clause.add(lit)) break;
+            if (!clause.is_tautology()) sum += clause.get()[0];
+        }
+        keep(sum);
+        return literal_lists->size();
+    }});
+
+    // Output variables of a dedup pass: a random forest over 2..n+1, then a find per variable
+    auto unions = std::make_shared<std::vector<std::pair<int, int>>>();
+    const int uf_size = 1 << 16;
+    {
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> var(2, uf_size + 1);
+        for (int i = 0; i < uf_size / 2; i++) unions->push_back({var(rng), var(rng)});
+    }
+
+    kernels.push_back({"union_find", "call", [unions, uf_size]() {
+        UnionFind<int> uf;
+        uf.reserve(uf_size + 2);
+        for (const auto& [a, b] : *unions) uf.unite(a, b);
+        int sum = 0;
+        for (int v = 2; v < uf_size + 2; v++) sum += uf.find(v);
+        keep(sum);
+        return unions->size() + uf_size;
+    }});
+
+    // D4 on a 32x32 box centered on the origin: rotation by 90 degrees and reflection in x
+    auto d4 = std::make_shared<std::vector<AffineTransf>>(std::vector<AffineTransf>{
+        {0, -1, 1, 0, 0, 0, 0}, {-1, 0, 0, 1, 0, 0, 0}});
+    const Bounds d4_box({-16, 16}, {-16, 16}, {0, 0});
+
+    kernels.push_back({"find_all_images", "point", [d4, d4_box]() {
+        size_t images = 0, points = 0;
+        for (int y = -16; y <= 16; y++)
+            for (int x = -16; x <= 16; x++, points++)
+                images += find_all_images({x, y, 0}, *d4, d4_box).size();
+        keep(images);
+        return points;
+    }});
+
+    // Neighborhoods over few variables so that about half of the signatures repeat
+    auto neighborhoods = std::make_shared<std::vector<std::array<int, 10>>>(make_transitions(8192, 12, 4));
+
+    kernels.push_back({"signature_hash", "transition", [neighborhoods]() {
+        using Signature = std::pair<int, std::array<int, 8>>;
+        static std::unordered_map<Signature, int, SignatureHash> sig_to_output;
+        sig_to_output.clear();
+        sig_to_output.reserve(neighborhoods->size() / 2);
+        size_t repeats = 0;
+        for (const auto& ten_cells : *neighborhoods) {
+            std::array<int, 8> neighbors;
+            std::copy(ten_cells.begin(), ten_cells.begin() + 4, neighbors.begin());
+            std::copy(ten_cells.begin() + 5, ten_cells.begin() + 9, neighbors.begin() + 4);
+            std::sort(neighbors.begin(), neighbors.end());
+            Signature sig = {ten_cells[4], neighbors};
+            auto it = sig_to_output.find(sig);
+            if (it == sig_to_output.end()) sig_to_output[sig] = ten_cells[9];
+            else repeats++;
+        }
+        keep(repeats);
+        return neighborhoods->size();
+    }});
+
+    // The clauses of 4096 transitions over 2000 variables
+    auto clauses = std::make_shared<ClauseList>();
+    {
+        ClauseBuilder clause;
+        for (const auto& ten_cells : *transitions) add_transition_clauses(ten_cells, clause, *clauses);
+    }
+
+    kernels.push_back({"make_dimacs_string", "clause", [clauses]() {
+        keep(make_dimacs_string(*clauses, 2000).size());
+        return clauses->size();
+    }});
+
+    // kissat-style output: 50000 variables, ten literals per "v" line
+    auto solver_output = std::make_shared<std::string>();
+    const int output_vars = 50000;
+    {
+        std::mt19937 rng(5);
+        std::ostringstream oss;
+        oss << "c some comment\ns SATISFIABLE\n";
+        for (int v = 1; v <= output_vars; v++) {
+            if ((v - 1) % 10 == 0) oss << (v > 1 ? "\n" : "") << "v";
+            oss << " " << (rng() & 1 ? v : -v);
+        }
+        oss << "\nv 0\n";
+        *solver_output = oss.str();
+    }
+
+    kernels.push_back({"parse_dimacs_output", "literal", [solver_output, output_vars]() {
+        keep(parse_dimacs_output(*solver_output).solution.size());
+        return size_t(output_vars);
+    }});
+
+    auto soup = [](int size, double density, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution alive(density);
+        BitPlane plane(-size / 2, -size / 2, size, size);
+        for (int y = -size / 2; y < size / 2; y++)
+            for (int x = -size / 2; x < size / 2; x++) plane.set(x, y, alive(rng));
+        return plane;
+    };
+
+    auto big_soup = std::make_shared<BitPlane>(soup(256, 0.35, 6).padded(1));
+    kernels.push_back({"life_step", "cell", [big_soup]() {
+        BitPlane next = life_step(*big_soup);
+        keep(next.width);
+        return size_t(big_soup->width) * big_soup->height;
+    }});
+
+    auto small_soup = std::make_shared<BitPlane>(soup(64, 0.35, 7));
+    kernels.push_back({"evolve_history", "generation", [small_soup]() {
+        keep(evolve_history(*small_soup, 100)->num_generations());
+        return size_t(100);
+    }});
+
+    return kernels;
+}
+
+// === Harness ===
+
+KernelResult measure(const Kernel& kernel, int samples, double min_time_ms) {
+    using clock = std::chrono::steady_clock;
+    KernelResult result;
+    result.name = kernel.name;
+    result.op = kernel.op;
+    result.ops_per_call = kernel.run();  // warmup
+    for (int s = 0; s < samples; s++) {
+        size_t ops = 0;
+        auto start = clock::now();
+        double elapsed_ns = 0;
+        do {
+            ops += kernel.run();
+            elapsed_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        } while (elapsed_ns < min_time_ms * 1e6);
+        result.samples_ns.push_back(elapsed_ns / ops);
+    }
+    return result;
+}
+
+void write_text(std::ostream& out, const std::vector<KernelResult>& results) {
+    out << std::left << std::setw(22) << "kernel" << std::setw(12) << "op" << std::right << std::setw(12)
+        << "ns/op" << std::setw(10) << "iqr" << std::setw(12) << "ops/call" << "\n";
+    for (const KernelResult& r : results) {
+        out << std::left << std::setw(22) << r.name << std::setw(12) << r.op << std::right << std::fixed
+            << std::setprecision(2) << std::setw(12) << median(r.samples_ns) << std::setw(10) << iqr(r.samples_ns)
+            << std::setw(12) << r.ops_per_call << "\n";
+    }
+}
+
+void write_json(std::ostream& out, const std::vector<KernelResult>& results) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"metadata\": {";
+    bool first_key = true;
+    for (const auto& [key, value] : run_metadata()) {
+        out << (first_key ? "" : ", ") << "\"" << key << "\": \"" << profiling::detail::json_escape(value) << "\"";
+        first_key = false;
+    }
+    out << "},\n \"kernels\": [";
+    for (size_t i = 0; i < results.size(); i++) {
+        const KernelResult& r = results[i];
+        out << (i ? ",\n" : "\n") << "  {\"name\": \"" << r.name << "\", \"op\": \"" << r.op
+            << "\", \"ops_per_call\": " << r.ops_per_call << ", \"ns_per_op\": " << median(r.samples_ns)
+            << ", \"iqr_ns\": " << iqr(r.samples_ns) << ", \"samples_ns\": [";
+        for (size_t k = 0; k < r.samples_ns.size(); k++) out << (k ? ", " : "") << r.samples_ns[k];
+        out << "]}";
+    }
+    out << "\n]}\n";
+}
+
+int main(int argc, char** argv) {
+    std::string filter, out_file;
+    int samples = 7;
+    double min_time_ms = 50;
+    bool json = false;
+
+    auto usage = [&]() {
+        std::cerr << "usage: " << argv[0] << " [--filter SUBSTRING] [--samples N] [--min-time MS] [--json] [--out FILE]\n";
+        return 2;
+    };
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") { json = true; continue; }
+        if (i + 1 >= argc) return usage();
+        std::string value = argv[++i];
+        if (arg == "--filter") filter = value;
+        else if (arg == "--samples") samples = std::max(1, std::stoi(value));
+        else if (arg == "--min-time") min_time_ms = std::max(0.0, std::stod(value));
+        else if (arg == "--out") out_file = value;
+        else return usage();
+    }
+
+    std::vector<KernelResult> results;
+    for (const Kernel& kernel : make_kernels()) {
+        if (!filter.empty() && kernel.name.find(filter) == std::string::npos) continue;
+        std::cerr << "micro: " << kernel.name << std::endl;
+        results.push_back(measure(kernel, samples, min_time_ms));
+    }
+
+    std::ofstream file;
+    if (!out_file.empty()) file = file_checks(out_file, true);
+    std::ostream& out = out_file.empty() ? std::cout : file;
+    if (json) write_json(out, results);
+    else write_text(out, results);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/*
+Scaling sweep: builds synthetic problems (synthetic.hpp) over a grid of sizes, kinds, symmetries
+and known-cell densities, and writes one CSV row per problem with the median phase times over
+the repeats and the resulting throughput:
+
+    kind,symmetry,width,height,generations,period,dx,dy,density,pipeline,cells,variables,clauses,
+    build_ms,dedup_ms,encode_ms,dimacs_ms,peak_rss_mb,build_cells_per_s,encode_cells_per_s,
+    encode_clauses_per_s,dimacs_clauses_per_s
+
+Phases are as in bench.cpp; cells = width * height * (generations + 1).
+
+Usage: scale [--kinds still,osc,ship] [--sizes 8,16,32] [--generations N] [--period N]
+             [--velocity DX,DY] [--symmetries none,rot180] [--densities 0,0.25]
+             [--pipeline grid|problem|both] [--repeats N] [--out FILE]
+*/
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include "synthetic.hpp"
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) if (!item.empty()) items.push_back(item);
+    return items;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    if (n == 0) return 0;
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// Events per second, or 0 for phases too short to measure
+double per_second(double count, double ms) { return ms > 0 ? count / (ms / 1e3) : 0; }
+
+void write_row(std::ostream& out, const SyntheticSpec& spec, int repeats) {
+    std::vector<double> build, dedup, encode, dimacs;
+    double peak_mb = 0;
+    ScenarioRun run;
+    for (int i = 0; i < repeats; i++) {
+        profiling::reset();
+        profiling::enable();
+        memory_stats::enable();
+        memory_stats::clear_phase_results();
+        run = run_synthetic(spec);
+        memory_stats::enable(false);
+        profiling::enable(false);
+
+        using profiling::timer_total_ns;
+        double dedup_ms = timer_total_ns("SearchProblem::build/dedup transitions") / 1e6;
+        dedup.push_back(dedup_ms);
+        build.push_back((timer_total_ns("construct_variable_grid") + timer_total_ns("SearchProblem::build")) / 1e6 - dedup_ms);
+        encode.push_back((timer_total_ns("calculate_clauses") + timer_total_ns("SearchProblem::get_clauses")) / 1e6);
+        dimacs.push_back(timer_total_ns("DIMACS gen") / 1e6);
+        for (const auto& [phase, stats] : memory_stats::phase_results())
+            peak_mb = std::max(peak_mb, stats.peak_rss / (1024.0 * 1024.0));
+    }
+    profiling::reset();
+
+    double cells = double(spec.width) * spec.height * (spec.generations + 1);
+    double build_ms = median(build), encode_ms = median(encode), dimacs_ms = median(dimacs);
+    out << kind_name(spec.kind) << "," << symmetry_name(spec.symmetry) << "," << spec.width << "," << spec.height
+        << "," << spec.generations << "," << spec.period << "," << spec.dx << "," << spec.dy
+        << "," << spec.known_density << "," << (spec.search_problem ? "problem" : "grid")
+        << "," << size_t(cells) << "," << run.variables << "," << run.clauses
+        << std::fixed << std::setprecision(3)
+        << "," << build_ms << "," << median(dedup) << "," << encode_ms << "," << dimacs_ms << "," << peak_mb
+        << std::setprecision(0)
+        << "," << per_second(cells, build_ms) << "," << per_second(cells, encode_ms)
+        << "," << per_second(run.clauses, encode_ms) << "," << per_second(run.clauses, dimacs_ms) << "\n";
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> kinds = {"still", "osc", "ship"}, symmetries = {"none", "rot180"};
+    std::vector<int> sizes = {8, 16, 24, 32};
+    std::vector<double> densities = {0};
+    int generations = 4, period = 2, dx = 1, dy = 0, repeats = 3;
+    std::string pipeline = "both", out_file;
+
+    auto usage = [&]() {
+        std::cerr << "usage: " << argv[0] << " [--kinds still,osc,ship] [--sizes 8,16,32] [--generations N] [--period N]\n"
+                  << "       [--velocity DX,DY] [--symmetries none,reflect_x,rot180,rot90,diagonal] [--densities 0,0.25]\n"
+                  << "       [--pipeline grid|problem|both] [--repeats N] [--out FILE]\n";
+        return 2;
+    };
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return usage();
+        std::string value = argv[++i];
+        if (arg == "--kinds") kinds = split(value);
+        else if (arg == "--sizes") { sizes.clear(); for (auto& s : split(value)) sizes.push_back(std::stoi(s)); }
+        else if (arg == "--generations") generations = std::stoi(value);
+        else if (arg == "--period") period = std::stoi(value);
+        else if (arg == "--velocity") { auto v = split(value); if (v.size() != 2) return usage(); dx = std::stoi(v[0]); dy = std::stoi(v[1]); }
+        else if (arg == "--symmetries") symmetries = split(value);
+        else if (arg == "--densities") { densities.clear(); for (auto& d : split(value)) densities.push_back(std::stod(d)); }
+        else if (arg == "--pipeline") pipeline = value;
+        else if (arg == "--repeats") repeats = std::max(1, std::stoi(value));
+        else if (arg == "--out") out_file = value;
+        else return usage();
+    }
+    if (pipeline != "grid" && pipeline != "problem" && pipeline != "both") return usage();
+
+    std::ofstream file;
+    if (!out_file.empty()) file = file_checks(out_file, true);
+    std::ostream& out = out_file.empty() ? std::cout : file;
+    out << "kind,symmetry,width,height,generations,period,dx,dy,density,pipeline,cells,variables,clauses,"
+           "build_ms,dedup_ms,encode_ms,dimacs_ms,peak_rss_mb,build_cells_per_s,encode_cells_per_s,"
+           "encode_clauses_per_s,dimacs_clauses_per_s\n";
+
+    logging::set_sink(std::make_shared<logging::NullSink>());
+    for (const std::string& kind : kinds) {
+        for (const std::string& symmetry : symmetries) {
+            for (double density : densities) {
+                for (int size : sizes) {
+                    for (bool search_problem : {false, true}) {
+                        if (pipeline != "both" && search_problem != (pipeline == "problem")) continue;
+                        SyntheticSpec spec;
+                        spec.kind = parse_kind(kind);
+                        spec.symmetry = parse_symmetry(symmetry);
+                        spec.width = spec.height = size;
+                        spec.generations = generations;
+                        spec.period = spec.kind == SyntheticKind::STILL_LIFE ? 1 : period;
+                        if (spec.kind == SyntheticKind::SPACESHIP) { spec.dx = dx; spec.dy = dy; }
+                        spec.known_density = density;
+                        spec.search_problem = search_problem;
+                        std::cerr << "scale: " << kind << " " << symmetry << " " << size << "x" << size
+                                  << " density " << density << (search_problem ? " problem" : " grid") << std::endl;
+                        write_row(out, spec, repeats);
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,179 @@
+#pragma once
+/*
+Benchmark scenarios: the search workloads from the tests (LWSS search, 2c/3 diagonal wire,
+P44 stable sparker), parameterized so that scaled-up variants can be generated.
+
+Each scenario builds its problem, encodes it and (optionally) solves it through the library's
+normal entry points, so the profiling timers inside those entry points see the same phases as
+in a real run. A scenario returns its variable and clause counts and the solver status.
+*/
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "../src/variable_grid.cpp"
+#include "../src/known_pattern.cpp"
+#include "../src/search_problem.hpp"
+#include "../src/solver.hpp"
+
+struct ScenarioRun {
+    int variables = 0;
+    size_t clauses = 0;
+    std::string status = "skipped";  // SAT, UNSAT, ERROR, or skipped when not solving
+};
+
+struct Scenario {
+    std::string name;
+    std::function<ScenarioRun(bool solve)> run;
+};
+
+// "At least one cell alive" for every generation of a variable grid
+inline BigClauseList at_least_one_alive_per_gen(const VariableGrid& var_grid) {
+    BigClauseList big_clauses;
+    for (int t = 0; t < var_grid.size_t(); t++) {
+        BigClause at_least_one_alive;
+        for (int y = 0; y < var_grid.size_y(); y++)
+            for (int x = 0; x < var_grid.size_x(); x++)
+                if (var_grid.grid[t][y][x] >= 2) at_least_one_alive.push_back(var_grid.grid[t][y][x] - 1);
+        if (!at_least_one_alive.empty()) big_clauses.push_back(at_least_one_alive);
+    }
+    return big_clauses;
+}
+
+// Encode (and solve) a VariablePattern through the VariableGrid pipeline.
+inline ScenarioRun run_variable_grid(const VariablePattern& pattern, bool solve_it,
+                                     const std::function<void(const VariableGrid&, ClauseList&)>& extra = nullptr) {
+    VariableGrid var_grid = construct_variable_grid(pattern);
+    ScenarioRun run;
+    ClauseList clauses = calculate_clauses(var_grid, run.variables);
+    for (int t = 0; t < var_grid.size_t(); t++)
+        for (int y = 0; y < var_grid.size_y(); y++)
+            for (int x = 0; x < var_grid.size_x(); x++)
+                run.variables = std::max(run.variables, var_grid.grid[t][y][x] - 1);
+    if (extra) extra(var_grid, clauses);
+    BigClauseList big_clauses = at_least_one_alive_per_gen(var_grid);
+    run.clauses = clauses.size() + big_clauses.size();
+    if (solve_it) run.status = solver_status_name(solve(clauses, run.variables, "kissat", big_clauses).status);
+    return run;
+}
+
+// LWSS search: a (width + 2) x (2 * half_height + 3) box with a dead border and the
+// glide-reflection (x, y, t) -> (x + 1, -y, t + 2). width = 6, half_height = 2 is test_lwss_solve.
+inline VariablePattern lwss_pattern(int width, int half_height) {
+    VariablePattern pattern(width + 2, 2 * half_height + 3, 2);
+    pattern.shift_by({-1, -half_height - 1, 0});
+    int lwss_group = pattern.add_cell_group({1, 0, 0, -1, 1, 0, 2});
+    pattern.set_cell_group_if(lwss_group, [](const Cell&) { return true; });
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    return pattern;
+}
+
+// 2c/3 diagonal wire in a size x size box, as in test_diagonal_wire (size = 20).
+inline VariablePattern diagonal_wire_pattern(int size) {
+    VariablePattern pattern(size, size, 3);
+    pattern.shift_by({-size / 2, -size / 2, 0});
+
+    CellGroup wire_group;
+    wire_group.spatial_transformations.push_back({1, 0, 0, 1, 2, 2, 0});
+    wire_group.time_transformation = {1, 0, 0, 1, 0, 0, 1};
+    int wire_group_idx = pattern.add_cell_group(wire_group);
+    int perturb_group_idx = pattern.add_cell_group({1, 0, 0, 1, 2, 2, 3});
+
+    pattern.set_cell_group_if(wire_group_idx, [&](const Cell& c) { return !pattern.is_boundary(c.position); });
+    pattern.set_cell_group_if(perturb_group_idx, [&](const Cell& c) {
+        auto [x, y, t] = c.position;
+        if (t <= 2) return x >= -1 && x <= 1 && y >= -1 && y <= 1;
+        return x >= 1 && x <= 3 && y >= 1 && y <= 3;
+    });
+    for (auto& cell : const_cast<CellList&>(pattern.get_cells()))
+        if (pattern.is_boundary(cell.position)) cell.follows_rules = false;
+    return pattern;
+}
+
+inline ScenarioRun run_diagonal_wire(int size, bool solve_it) {
+    VariablePattern pattern = diagonal_wire_pattern(size);
+    // the perturbation must change the center cell
+    auto xor_center = [size](const VariableGrid& var_grid, ClauseList& clauses) {
+        int c = size / 2;
+        int v0 = var_grid.grid[0][c][c], v1 = var_grid.grid[1][c][c];
+        if (v0 >= 2 && v1 >= 2 && v0 != v1) {
+            clauses.emplace_back(make_clause({v0 - 1, v1 - 1}));
+            clauses.emplace_back(make_clause({-(v0 - 1), -(v1 - 1)}));
+        }
+    };
+    return run_variable_grid(pattern, solve_it, xor_center);
+}
+
+const std::string P22_RLE = R"(x = 49, y = 31, rule = B3/S23
+22b2o7bo$23bo8bo2bo$23bobo4bo4bo4b2o$24b2o13bo2bo$29bo8b2ob2o$28b2ob2o
+8bo$28bo2bo13b2o$29b2o4bo4bo4bobo$35bo2bo8bo$39bo7b2o4$23bo8b2o$16bo5b
+2o7bobo$15bobo3bo10bo$15b2o5bobo$22bobo2$19b2o$2o16bo2bo$bo16b2obo$bob
+o4b3o5bo2b2o$2b2o4bobo4bo$7bo3bo3bo3bo$7bo3bo3bo3bo$11bo4bobo4b2o$6b2o
+2bo5b3o4bobo$5bob2o16bo$5bo2bo16b2o$6b2o!)";
+
+// Stable catalysts replacing half of the P44 oscillator, as in test_stable_sparker. `margin` trims
+// the search box on every side (8 x 7 in the test; smaller margins give larger problems).
+inline ScenarioRun run_p44_sparker(bool spatial_symmetry, int x_margin, int y_margin, bool solve_it) {
+    const int max_gen = 22;
+    KnownPattern p22(P22_RLE, max_gen);
+    auto [bx, by, bt] = p22.get_bounds();
+    p22.shift_by(Point(-(bx.first + bx.second) / 2, -(by.first + by.second) / 2, 0));
+    auto [xlims, ylims, tlims] = p22.get_bounds();
+    Bounds box({xlims.first + x_margin, xlims.second - x_margin},
+               {ylims.first + y_margin, ylims.second - y_margin}, {0, max_gen});
+    Limits lom_xlims = {-4, 4}, lom_ylims = {-2, 3};
+
+    VariablePattern stable_catalyst(box);
+    {
+        CellGroup border_group;
+        border_group.time_transformation = {1, 0, 0, 1, 0, 0, 1};
+        if (spatial_symmetry) border_group.spatial_transformations.push_back({-1, 0, 0, -1, 0, 1, 0});
+        int border_idx = stable_catalyst.add_cell_group(border_group);
+        CellGroup stable_group;
+        stable_group.time_transformation = {1, 0, 0, 1, 0, 0, 1};
+        if (spatial_symmetry) stable_group.spatial_transformations.push_back({-1, 0, 0, -1, 0, 1, 0});
+        int stable_idx = stable_catalyst.add_cell_group(stable_group);
+        stable_catalyst.set_cell_group_if(stable_idx, [&](const Cell& c) { return !stable_catalyst.is_boundary(c.position); });
+        stable_catalyst.set_cell_group_if(border_idx, [&](const Cell& c) { return stable_catalyst.is_boundary(c.position); });
+        stable_catalyst.set_known_if(false, [&](const Cell& c) { return stable_catalyst.is_boundary(c.position); });
+    }
+
+    VariablePattern interaction(box);
+    if (spatial_symmetry) {
+        CellGroup interaction_group;
+        interaction_group.time_transformation = {-1, 0, 0, -1, 0, 1, 11};
+        int idx = interaction.add_cell_group(interaction_group);
+        interaction.set_cell_group_if(idx, [](const Cell&) { return true; });
+    }
+
+    auto in_lom = [=](Point p) {
+        auto [x, y, t] = p;
+        return x >= lom_xlims.first && x <= lom_xlims.second && y >= lom_ylims.first && y <= lom_ylims.second;
+    };
+    auto settled = [](int t) { return t <= 4 || (t >= 10 && t <= 15) || t >= 21; };
+    SearchProblem problem(box);
+    problem.add_entry(&p22, [=](Point p) { return in_lom(p) && settled(std::get<2>(p)); });
+    problem.add_entry(&stable_catalyst, [=](Point p) { return !in_lom(p) && settled(std::get<2>(p)); });
+    problem.add_entry(&interaction, [=](Point p) { return !settled(std::get<2>(p)); });
+    problem.build();
+
+    ScenarioRun run;
+    ClauseList clauses = problem.get_clauses();
+    run.variables = problem.num_variables();
+    run.clauses = clauses.size();
+    if (solve_it) run.status = solver_status_name(solve(clauses, run.variables).status);
+    return run;
+}
+
+// The test workloads followed by scaled-up variants.
+inline std::vector<Scenario> all_scenarios() {
+    return {
+        {"lwss", [](bool s) { return run_variable_grid(lwss_pattern(6, 2), s); }},
+        {"lwss_12x11", [](bool s) { return run_variable_grid(lwss_pattern(12, 4), s); }},
+        {"diagonal_wire", [](bool s) { return run_diagonal_wire(20, s); }},
+        {"diagonal_wire_40", [](bool s) { return run_diagonal_wire(40, s); }},
+        {"p44_sparker", [](bool s) { return run_p44_sparker(true, 8, 7, s); }},
+        {"p44_sparker_wide", [](bool s) { return run_p44_sparker(true, 4, 3, s); }},
+        {"p44_sparker_nosym", [](bool s) { return run_p44_sparker(false, 8, 7, s); }},
+    };
+}
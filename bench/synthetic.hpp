@@ -0,0 +1,129 @@
+#pragma once
+/*
+Synthetic search problems for scaling measurements: a width x height box over a number of
+generations, filled with one cell group that makes the pattern a still life, an oscillator of a
+given period or a spaceship of a given displacement per period, optionally with a spatial
+symmetry and a fraction of interior generation-0 cells fixed dead (the cell group carries them
+through time). The box border is known dead.
+
+make_synthetic_pattern() builds the VariablePattern; run_synthetic() pushes it through either
+the VariableGrid pipeline or a single-entry SearchProblem, as in scenarios.hpp.
+*/
+
+#include <random>
+#include <string>
+#include <stdexcept>
+#include "scenarios.hpp"
+
+enum class SyntheticKind { STILL_LIFE, OSCILLATOR, SPACESHIP };
+enum class SyntheticSymmetry { NONE, REFLECT_X, ROTATE_180, ROTATE_90, DIAGONAL };
+
+struct SyntheticSpec {
+    SyntheticKind kind = SyntheticKind::STILL_LIFE;
+    int width = 8, height = 8;
+    int generations = 1;           // transitions; the box has generations + 1 generations
+    int period = 1;                // oscillators and spaceships
+    int dx = 0, dy = 0;            // spaceship displacement per period
+    SyntheticSymmetry symmetry = SyntheticSymmetry::NONE;
+    double known_density = 0;      // fraction of interior generation-0 cells fixed dead
+    unsigned seed = 1;
+    bool search_problem = false;   // SearchProblem pipeline instead of VariableGrid
+};
+
+inline const char* kind_name(SyntheticKind kind) {
+    switch (kind) {
+        case SyntheticKind::STILL_LIFE: return "still";
+        case SyntheticKind::OSCILLATOR: return "osc";
+        default: return "ship";
+    }
+}
+
+inline const char* symmetry_name(SyntheticSymmetry symmetry) {
+    switch (symmetry) {
+        case SyntheticSymmetry::NONE: return "none";
+        case SyntheticSymmetry::REFLECT_X: return "reflect_x";
+        case SyntheticSymmetry::ROTATE_180: return "rot180";
+        case SyntheticSymmetry::ROTATE_90: return "rot90";
+        default: return "diagonal";
+    }
+}
+
+inline SyntheticKind parse_kind(const std::string& name) {
+    for (SyntheticKind k : {SyntheticKind::STILL_LIFE, SyntheticKind::OSCILLATOR, SyntheticKind::SPACESHIP})
+        if (name == kind_name(k)) return k;
+    throw std::runtime_error("Unknown pattern kind: " + name);
+}
+
+inline SyntheticSymmetry parse_symmetry(const std::string& name) {
+    for (SyntheticSymmetry s : {SyntheticSymmetry::NONE, SyntheticSymmetry::REFLECT_X, SyntheticSymmetry::ROTATE_180,
+                                SyntheticSymmetry::ROTATE_90, SyntheticSymmetry::DIAGONAL})
+        if (name == symmetry_name(s)) return s;
+    throw std::runtime_error("Unknown symmetry: " + name);
+}
+
+inline VariablePattern make_synthetic_pattern(const SyntheticSpec& spec) {
+    bool square_only = spec.symmetry == SyntheticSymmetry::ROTATE_90 || spec.symmetry == SyntheticSymmetry::DIAGONAL;
+    if (square_only && spec.width != spec.height)
+        throw std::runtime_error(std::string("Symmetry ") + symmetry_name(spec.symmetry) + " needs a square box");
+
+    // Centered box; sx, sy are xmin + xmax and ymin + ymax, so x -> sx - x reflects it onto itself
+    int x0 = -spec.width / 2, y0 = -spec.height / 2;
+    Bounds box({x0, x0 + spec.width - 1}, {y0, y0 + spec.height - 1}, {0, spec.generations});
+    int sx = 2 * x0 + spec.width - 1, sy = 2 * y0 + spec.height - 1;
+    VariablePattern pattern(box);
+
+    CellGroup group;
+    switch (spec.kind) {
+        case SyntheticKind::STILL_LIFE: group.time_transformation = {1, 0, 0, 1, 0, 0, 1}; break;
+        case SyntheticKind::OSCILLATOR: group.time_transformation = {1, 0, 0, 1, 0, 0, spec.period}; break;
+        case SyntheticKind::SPACESHIP: group.time_transformation = {1, 0, 0, 1, spec.dx, spec.dy, spec.period}; break;
+    }
+    switch (spec.symmetry) {
+        case SyntheticSymmetry::NONE: break;
+        case SyntheticSymmetry::REFLECT_X: group.spatial_transformations.push_back({-1, 0, 0, 1, sx, 0, 0}); break;
+        case SyntheticSymmetry::ROTATE_180: group.spatial_transformations.push_back({-1, 0, 0, -1, sx, sy, 0}); break;
+        case SyntheticSymmetry::ROTATE_90: group.spatial_transformations.push_back({0, -1, 1, 0, sx, 0, 0}); break;
+        case SyntheticSymmetry::DIAGONAL: group.spatial_transformations.push_back({0, 1, 1, 0, 0, 0, 0}); break;
+    }
+    int group_idx = pattern.add_cell_group(group);
+    pattern.set_cell_group_if(group_idx, [](const Cell&) { return true; });
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+
+    if (spec.known_density > 0) {
+        std::mt19937 rng(spec.seed);
+        std::bernoulli_distribution fixed(spec.known_density);
+        pattern.set_known_if(false, [&](const Cell& c) {
+            return std::get<2>(c.position) == 0 && !pattern.is_boundary(c.position) && fixed(rng);
+        });
+    }
+    return pattern;
+}
+
+// Build and encode one synthetic problem, then write its DIMACS text (timed as "DIMACS gen")
+// without solving. Phase times come from the profiling timers inside the library calls.
+inline ScenarioRun run_synthetic(const SyntheticSpec& spec) {
+    VariablePattern pattern = make_synthetic_pattern(spec);
+    auto dimacs = [](const ClauseList& clauses, int num_variables) {
+        profiling::ScopedTimer timer("DIMACS gen");
+        return make_dimacs_string(clauses, num_variables).size();
+    };
+    if (!spec.search_problem) {
+        return run_variable_grid(pattern, false, [&](const VariableGrid& var_grid, ClauseList& clauses) {
+            int num_variables = 0;
+            for (const auto& plane : var_grid.grid)
+                for (const auto& row : plane)
+                    for (int v : row) num_variables = std::max(num_variables, v - 1);
+            dimacs(clauses, num_variables);
+        });
+    }
+
+    SearchProblem problem(pattern.get_bounds());
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.build();
+    ScenarioRun run;
+    ClauseList clauses = problem.get_clauses();
+    run.variables = problem.num_variables();
+    run.clauses = clauses.size();
+    dimacs(clauses, run.variables);
+    return run;
+}
@@ -0,0 +1,156 @@
+#pragma once
+/*
+apgcodes: the canonical names Catagolue uses for still lifes (xs), oscillators (xp) and
+spaceships (xq), e.g. xs4_33 (block), xp2_7 (blinker), xq4_153 (glider).
+
+The body is extended Wechsler notation: the pattern is cut into strips 5 rows tall, each strip
+is written column by column as one base-32 digit (top row = least significant bit), 'z' separates
+strips, and runs of empty columns are abbreviated ('w' = 2, 'x' = 3, 'y' + digit = 4 to 39).
+
+The canonical code is the shortest, then lexicographically smallest, encoding over all phases
+and all 8 orientations.
+*/
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "bitboard.hpp"
+#include "period.hpp"
+
+namespace apgcode_detail {
+
+inline const char* DIGITS = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+inline int digit_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 10;
+    throw std::runtime_error(std::string("apgcode: invalid character '") + c + "'");
+}
+
+inline void append_zeros(std::string& out, int zeros) {
+    while (zeros > 39) {
+        out += "yz";
+        zeros -= 39;
+    }
+    if (zeros == 1) out += '0';
+    else if (zeros == 2) out += 'w';
+    else if (zeros == 3) out += 'x';
+    else if (zeros >= 4) {
+        out += 'y';
+        out += DIGITS[zeros - 4];
+    }
+}
+
+}  // namespace apgcode_detail
+
+// Wechsler encoding of a plane's live cells, relative to their bounding box.
+inline std::string wechsler(const BitPlane& plane) {
+    using namespace apgcode_detail;
+    int xmin, xmax, ymin, ymax;
+    if (!plane.live_bounds(xmin, xmax, ymin, ymax)) return "";
+    std::string out;
+    for (int strip_y = ymin; strip_y <= ymax; strip_y += 5) {
+        if (strip_y != ymin) out += 'z';
+        // the up to 5 rows of this strip
+        const uint64_t* rows[5] = {nullptr, nullptr, nullptr, nullptr, nullptr};
+        for (int r = 0; r < 5 && strip_y + r <= ymax; r++)
+            rows[r] = plane.row(strip_y + r - plane.y0);
+        int zeros = 0;
+        for (int x = xmin; x <= xmax; x++) {
+            int lx = x - plane.x0;
+            int value = 0;
+            for (int r = 0; r < 5; r++)
+                if (rows[r] && ((rows[r][lx >> 6] >> (lx & 63)) & 1)) value |= 1 << r;
+            if (value == 0) {
+                zeros++;
+                continue;
+            }
+            append_zeros(out, zeros);
+            zeros = 0;
+            out += DIGITS[value];
+        }
+    }
+    return out;
+}
+
+// Decode a Wechsler string into a plane with its upper-left corner at (0, 0).
+inline BitPlane decode_wechsler(const std::string& code) {
+    using namespace apgcode_detail;
+    std::vector<std::pair<int, int>> cells;
+    int x = 0, strip_y = 0, width = 0, height = 0;
+    for (size_t i = 0; i < code.size(); i++) {
+        char c = code[i];
+        if (c == 'z') {
+            strip_y += 5;
+            x = 0;
+        } else if (c == 'w') {
+            x += 2;
+        } else if (c == 'x') {
+            x += 3;
+        } else if (c == 'y') {
+            if (++i >= code.size()) throw std::runtime_error("apgcode: truncated 'y' run");
+            x += 4 + digit_value(code[i]);
+        } else {
+            int value = digit_value(c);
+            if (value >= 32) throw std::runtime_error(std::string("apgcode: invalid character '") + c + "'");
+            for (int r = 0; r < 5; r++) {
+                if (value & (1 << r)) {
+                    cells.push_back({x, strip_y + r});
+                    width = std::max(width, x + 1);
+                    height = std::max(height, strip_y + r + 1);
+                }
+            }
+            x++;
+        }
+    }
+    BitPlane plane(0, 0, width, height);
+    for (auto [cx, cy] : cells) plane.set(cx, cy, true);
+    return plane;
+}
+
+// Canonical Wechsler over the 8 orientations (shortest, then lexicographically smallest).
+inline std::string canonical_wechsler(const BitPlane& plane) {
+    std::string best;
+    for (int orientation = 0; orientation < 8; orientation++) {
+        std::string code = wechsler(transformed(plane, orientation));
+        if (orientation == 0 || code.size() < best.size() || (code.size() == best.size() && code < best))
+            best = code;
+    }
+    return best;
+}
+
+// apgcode of a pattern given as its generation 0. The pattern is evolved for up to max_period
+// generations to find its period and displacement; throws if it does not repeat by then.
+inline std::string encode_apgcode(const BitPlane& gen0, int max_period = 1024) {
+    BitPlane start = gen0.trimmed();
+    if (start.width == 0) return "xs0_0";
+    std::vector<BitPlane> phases;
+    PeriodInfo info = detect_period(start, max_period, false, &phases);
+    if (!info.found && phases.back().width == 0) throw std::runtime_error("apgcode: pattern dies out");
+    if (!info.found)
+        throw std::runtime_error("apgcode: no period found within " + std::to_string(max_period) + " generations");
+    int period = info.period;
+    bool moves = info.moves();
+
+    std::string best;
+    for (const BitPlane& phase : phases) {
+        std::string code = canonical_wechsler(phase);
+        if (best.empty() || code.size() < best.size() || (code.size() == best.size() && code < best))
+            best = code;
+    }
+    if (moves) return "xq" + std::to_string(period) + "_" + best;
+    if (period > 1) return "xp" + std::to_string(period) + "_" + best;
+    return "xs" + std::to_string(start.population()) + "_" + best;
+}
+
+// Generation 0 of an xs/xp/xq apgcode, with its upper-left corner at (0, 0).
+inline BitPlane decode_apgcode(const std::string& code) {
+    size_t underscore = code.find('_');
+    if (code.size() < 4 || underscore == std::string::npos ||
+            (code.compare(0, 2, "xs") != 0 && code.compare(0, 2, "xp") != 0 && code.compare(0, 2, "xq") != 0))
+        throw std::runtime_error("apgcode: expected xs/xp/xq code, got '" + code + "'");
+    for (size_t i = 2; i < underscore; i++)
+        if (code[i] < '0' || code[i] > '9')
+            throw std::runtime_error("apgcode: invalid prefix in '" + code + "'");
+    return decode_wechsler(code.substr(underscore + 1));
+}
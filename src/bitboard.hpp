@@ -0,0 +1,337 @@
+#pragma once
+/*
+BitPlane: one generation of a known pattern, stored as a dense bit-packed rectangle.
+
+Each row is `stride` 64-bit words; bit i of word k in local row ly is the cell at
+(x0 + 64 * k + i, y0 + ly). Bits past `width` in the last word of a row are always 0.
+BitPlaneView is a read-only view with the same layout over words owned elsewhere.
+
+life_step() computes the next B3/S23 generation with bitwise full-adder neighbor counting,
+64 cells per word. The word loop is written over a generic word type so that it is widened
+to 4 words per operation with GCC vector extensions where available (SSE2/AVX2 codegen).
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace bitboard_detail {
+
+// out[j] = 64 bits of src starting at bit (offset + 64 * j); bits outside [0, 64 * stride) read as 0.
+inline void extract_bits(const uint64_t* src, int stride, int offset, uint64_t* out, int out_words) {
+    auto word_at = [&](long k) -> uint64_t {
+        return (k < 0 || k >= stride) ? 0 : src[k];
+    };
+    for (int j = 0; j < out_words; j++) {
+        long bit = long(offset) + 64L * j;
+        long k = bit >= 0 ? bit / 64 : -((-bit + 63) / 64);
+        int r = int(bit - 64 * k);
+        uint64_t w = word_at(k) >> r;
+        if (r) w |= word_at(k + 1) << (64 - r);
+        out[j] = w;
+    }
+}
+
+}  // namespace bitboard_detail
+
+struct BitPlane {
+    int x0 = 0, y0 = 0;          // position of the upper-left cell
+    int width = 0, height = 0;
+    int stride = 0;              // 64-bit words per row
+    std::vector<uint64_t> words; // height * stride words, row-major
+
+    BitPlane() = default;
+
+    BitPlane(int x0, int y0, int width, int height)
+        : x0(x0), y0(y0), width(std::max(width, 0)), height(std::max(height, 0)),
+          stride((std::max(width, 0) + 63) / 64),
+          words(size_t(stride) * this->height, 0) {}
+
+    bool in_plane(int x, int y) const {
+        return x >= x0 && x < x0 + width && y >= y0 && y < y0 + height;
+    }
+
+    // State of the cell at absolute position (x, y); cells outside the plane are dead.
+    bool get(int x, int y) const {
+        if (!in_plane(x, y)) return false;
+        int lx = x - x0;
+        return (words[size_t(y - y0) * stride + (lx >> 6)] >> (lx & 63)) & 1;
+    }
+
+    // Set the cell at absolute position (x, y). Precondition: in_plane(x, y).
+    void set(int x, int y, bool state) {
+        int lx = x - x0;
+        uint64_t& w = words[size_t(y - y0) * stride + (lx >> 6)];
+        uint64_t bit = uint64_t(1) << (lx & 63);
+        if (state) w |= bit; else w &= ~bit;
+    }
+
+    // Words of local row ly (0 <= ly < height)
+    const uint64_t* row(int ly) const { return words.data() + size_t(ly) * stride; }
+    uint64_t* row(int ly) { return words.data() + size_t(ly) * stride; }
+
+    int population() const {
+        int pop = 0;
+        for (uint64_t w : words) pop += __builtin_popcountll(w);
+        return pop;
+    }
+
+    bool empty() const {
+        for (uint64_t w : words)
+            if (w) return false;
+        return true;
+    }
+
+    // Bounding box of live cells in absolute coordinates. Returns false if there are none.
+    bool live_bounds(int& xmin, int& xmax, int& ymin, int& ymax) const {
+        bool found = false;
+        int lo = width, hi = -1;
+        for (int ly = 0; ly < height; ly++) {
+            const uint64_t* r = row(ly);
+            for (int k = 0; k < stride; k++) {
+                if (!r[k]) continue;
+                lo = std::min(lo, 64 * k + __builtin_ctzll(r[k]));
+                hi = std::max(hi, 64 * k + 63 - __builtin_clzll(r[k]));
+                if (!found) ymin = y0 + ly;
+                ymax = y0 + ly;
+                found = true;
+            }
+        }
+        if (found) {
+            xmin = x0 + lo;
+            xmax = x0 + hi;
+        }
+        return found;
+    }
+
+    // True if every cell on the outermost ring of the plane is dead, i.e. the next
+    // generation cannot have live cells outside the plane.
+    bool border_clear() const {
+        if (width == 0 || height == 0) return true;
+        for (int k = 0; k < stride; k++)
+            if (row(0)[k] || row(height - 1)[k]) return false;
+        int last = width - 1;
+        for (int ly = 0; ly < height; ly++) {
+            const uint64_t* r = row(ly);
+            if ((r[0] & 1) || ((r[last >> 6] >> (last & 63)) & 1)) return false;
+        }
+        return true;
+    }
+
+    // Copy of the rectangle [nx0, nx0 + nwidth) x [ny0, ny0 + nheight); cells outside this plane are dead.
+    BitPlane cropped(int nx0, int ny0, int nwidth, int nheight) const {
+        BitPlane out(nx0, ny0, nwidth, nheight);
+        int offset = nx0 - x0;  // bit offset of the new row start within a source row
+        for (int ly = 0; ly < out.height; ly++) {
+            int sy = ny0 + ly - y0;
+            if (sy < 0 || sy >= height) continue;
+            bitboard_detail::extract_bits(row(sy), stride, offset, out.row(ly), out.stride);
+        }
+        out.mask_tails();
+        return out;
+    }
+
+    // Copy shrunk to the bounding box of the live cells (an empty plane if there are none).
+    BitPlane trimmed() const {
+        int xmin, xmax, ymin, ymax;
+        if (!live_bounds(xmin, xmax, ymin, ymax)) return BitPlane(x0, y0, 0, 0);
+        return cropped(xmin, ymin, xmax - xmin + 1, ymax - ymin + 1);
+    }
+
+    // Copy grown by `margin` dead cells on every side.
+    BitPlane padded(int margin) const {
+        return cropped(x0 - margin, y0 - margin, width + 2 * margin, height + 2 * margin);
+    }
+
+    // Clear the unused bits past `width` in the last word of every row.
+    void mask_tails() {
+        if (width % 64 == 0) return;
+        uint64_t mask = (uint64_t(1) << (width % 64)) - 1;
+        for (int ly = 0; ly < height; ly++)
+            row(ly)[stride - 1] &= mask;
+    }
+};
+
+inline bool operator==(const BitPlane& a, const BitPlane& b) {
+    return a.x0 == b.x0 && a.y0 == b.y0 && a.width == b.width && a.height == b.height && a.words == b.words;
+}
+
+inline bool operator!=(const BitPlane& a, const BitPlane& b) {
+    return !(a == b);
+}
+
+// Read-only view of a plane's words, laid out as in BitPlane but owned elsewhere, e.g. by a
+// BitPlane or a memory-mapped file.
+struct BitPlaneView {
+    int x0 = 0, y0 = 0;
+    int width = 0, height = 0;
+    int stride = 0;
+    const uint64_t* words = nullptr;
+
+    BitPlaneView() = default;
+    BitPlaneView(const BitPlane& plane)
+        : x0(plane.x0), y0(plane.y0), width(plane.width), height(plane.height), stride(plane.stride),
+          words(plane.words.data()) {}
+
+    bool in_plane(int x, int y) const {
+        return x >= x0 && x < x0 + width && y >= y0 && y < y0 + height;
+    }
+
+    bool get(int x, int y) const {
+        if (!in_plane(x, y)) return false;
+        int lx = x - x0;
+        return (words[size_t(y - y0) * stride + (lx >> 6)] >> (lx & 63)) & 1;
+    }
+
+    const uint64_t* row(int ly) const { return words + size_t(ly) * stride; }
+
+    // Copy of the rectangle [nx0, nx0 + nwidth) x [ny0, ny0 + nheight), as BitPlane::cropped.
+    BitPlane cropped(int nx0, int ny0, int nwidth, int nheight) const {
+        BitPlane out(nx0, ny0, nwidth, nheight);
+        for (int ly = 0; ly < out.height; ly++) {
+            int sy = ny0 + ly - y0;
+            if (sy < 0 || sy >= height) continue;
+            bitboard_detail::extract_bits(row(sy), stride, nx0 - x0, out.row(ly), out.stride);
+        }
+        out.mask_tails();
+        return out;
+    }
+
+    BitPlane to_plane() const { return cropped(x0, y0, width, height); }
+};
+
+namespace bitboard_detail {
+
+// Next state of 64 (or VECTOR_WORDS x 64) cells given the 9 shifted neighborhood words.
+// ul/u/ur: row above shifted so that the left/center/right neighbor lines up with each cell, etc.
+// Neighbor count is summed with full adders into bits (s0, s1, s2), modulo 8; a count of 8
+// wraps to 0, which is dead under B3/S23 anyway.
+template<typename W>
+inline W life_kernel(W ul, W u, W ur, W ml, W m, W mr, W dl, W d, W dr) {
+    W su = ul ^ u ^ ur;
+    W cu = (ul & u) | (ur & (ul ^ u));
+    W sm = ml ^ mr;
+    W cm = ml & mr;
+    W sd = dl ^ d ^ dr;
+    W cd = (dl & d) | (dr & (dl ^ d));
+
+    W s0 = su ^ sm ^ sd;
+    W c0 = (su & sm) | (sd & (su ^ sm));
+
+    W t1 = cu ^ cm ^ cd;
+    W k1 = (cu & cm) | (cd & (cu ^ cm));
+    W s1 = t1 ^ c0;
+    W k2 = t1 & c0;
+    W s2 = k1 ^ k2;
+
+    // alive iff count is 3, or count is 2 and the cell is alive
+    return s1 & ~s2 & (s0 | m);
+}
+
+#if defined(__GNUC__)
+// 32-byte vectors only where AVX2 passes them in registers; without it, GCC warns (-Wpsabi) that
+// their calling convention differs, so the portable build uses 16-byte vectors (SSE2 / NEON)
+#if defined(__AVX2__)
+constexpr size_t VECTOR_WORDS = 4;
+#else
+constexpr size_t VECTOR_WORDS = 2;
+#endif
+typedef uint64_t wordv __attribute__((vector_size(8 * VECTOR_WORDS)));
+
+inline wordv loadv(const uint64_t* p) {
+    wordv v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+#endif
+
+}  // namespace bitboard_detail
+
+// Compute the next generation over the same rectangle. Cells outside the plane are treated as
+// dead, so the result is exact whenever plane.border_clear() holds.
+inline BitPlane life_step(const BitPlane& plane) {
+    using namespace bitboard_detail;
+    BitPlane next(plane.x0, plane.y0, plane.width, plane.height);
+    if (plane.width == 0 || plane.height == 0) return next;
+
+    int s = plane.stride;
+    size_t n = size_t(plane.height) * s;
+    // Shifted copies with one zero row of padding above and below, so the kernel loop is branch-free.
+    // left[i]: neighbor at x-1 aligned to x; right[i]: neighbor at x+1 aligned to x.
+    std::vector<uint64_t> center(n + 2 * s, 0), left(n + 2 * s, 0), right(n + 2 * s, 0);
+    for (int ly = 0; ly < plane.height; ly++) {
+        const uint64_t* r = plane.row(ly);
+        size_t base = size_t(ly + 1) * s;
+        for (int k = 0; k < s; k++) {
+            uint64_t prev = k > 0 ? r[k - 1] : 0;
+            uint64_t nxt = k + 1 < s ? r[k + 1] : 0;
+            center[base + k] = r[k];
+            left[base + k] = (r[k] << 1) | (prev >> 63);
+            right[base + k] = (r[k] >> 1) | (nxt << 63);
+        }
+    }
+
+    const uint64_t* C = center.data() + s;
+    const uint64_t* L = left.data() + s;
+    const uint64_t* R = right.data() + s;
+    uint64_t* out = next.words.data();
+    size_t i = 0;
+#if defined(__GNUC__)
+    for (; i + VECTOR_WORDS <= n; i += VECTOR_WORDS) {
+        wordv v = life_kernel(loadv(L + i - s), loadv(C + i - s), loadv(R + i - s),
+                              loadv(L + i), loadv(C + i), loadv(R + i),
+                              loadv(L + i + s), loadv(C + i + s), loadv(R + i + s));
+        std::memcpy(out + i, &v, sizeof(v));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = life_kernel(L[i - s], C[i - s], R[i - s], L[i], C[i], R[i], L[i + s], C[i + s], R[i + s]);
+    }
+    next.mask_tails();
+    return next;
+}
+
+// The 8 symmetries of the square, as (a1, a2, a3, a4): (x, y) -> (a1 x + a2 y, a3 x + a4 y).
+// Same convention as the linear part of an AffineTransf. Entries 0-3 are rotations, 4-7 reflections.
+inline constexpr int D4_TRANSFORMS[8][4] = {
+    {1, 0, 0, 1}, {0, -1, 1, 0}, {-1, 0, 0, -1}, {0, 1, -1, 0},
+    {-1, 0, 0, 1}, {1, 0, 0, -1}, {0, 1, 1, 0}, {0, -1, -1, 0}
+};
+
+// Image of a plane under one of the D4_TRANSFORMS, in absolute coordinates. Only live cells are
+// visited, so the cost is proportional to the population plus the plane's word count.
+inline BitPlane transformed(const BitPlane& plane, int orientation) {
+    const int* a = D4_TRANSFORMS[orientation];
+    int xs[2] = {plane.x0, plane.x0 + plane.width - 1};
+    int ys[2] = {plane.y0, plane.y0 + plane.height - 1};
+    int xmin = 0, xmax = 0, ymin = 0, ymax = 0;
+    for (int i = 0; i < 4; i++) {
+        int x = a[0] * xs[i & 1] + a[1] * ys[i >> 1];
+        int y = a[2] * xs[i & 1] + a[3] * ys[i >> 1];
+        if (i == 0 || x < xmin) xmin = x;
+        if (i == 0 || x > xmax) xmax = x;
+        if (i == 0 || y < ymin) ymin = y;
+        if (i == 0 || y > ymax) ymax = y;
+    }
+    if (plane.width == 0 || plane.height == 0) return BitPlane(xmin, ymin, 0, 0);
+    BitPlane out(xmin, ymin, xmax - xmin + 1, ymax - ymin + 1);
+    for (int ly = 0; ly < plane.height; ly++) {
+        const uint64_t* r = plane.row(ly);
+        int y = plane.y0 + ly;
+        for (int k = 0; k < plane.stride; k++) {
+            for (uint64_t w = r[k]; w; w &= w - 1) {
+                int x = plane.x0 + 64 * k + __builtin_ctzll(w);
+                out.set(a[0] * x + a[1] * y, a[2] * x + a[3] * y, true);
+            }
+        }
+    }
+    return out;
+}
+
+// Copy of a plane moved so that its upper-left cell is at (x0, y0).
+inline BitPlane translated_to(BitPlane plane, int x0, int y0) {
+    plane.x0 = x0;
+    plane.y0 = y0;
+    return plane;
+}
@@ -0,0 +1,302 @@
+#pragma once
+/*
+Cardinality constraints: lo <= (number of true literals) <= hi, as clauses over auxiliary
+variables numbered after the problem's, so that bounds like "at most 12 live cells in generation 0"
+or "between 3 and 6 live cells in this region" need no hand-written (exponential) clause lists.
+
+    CardinalityEncoder encoder(problem.num_variables());
+    BigClauseList big_clauses;
+    add_population_bounds(big_clauses, encoder, generation_sum(problem, 0), 1, 12);
+    solve(problem.get_clauses(), encoder.num_variables(), "kissat", big_clauses);
+
+Encodings (n literals, bound k):
+- SEQUENTIAL_COUNTER (Sinz): a unary counter per prefix, about 2nk clauses; best for small k.
+- TOTALIZER (Bailleux & Boufkhad): a tree of unary sums, each node capped at the largest count a
+  bound looks at; its outputs can also be bounded later by assumptions (see totalizer()).
+- SORTING_NETWORK (Batcher's odd-even merge sort): O(n log^2 n) comparators whatever k is; best
+  when k is close to n / 2 on large sets.
+AUTO estimates the clause count of each and picks the smallest. Only the direction a bound needs
+is encoded: counts that are too high for an upper bound, too low for a lower one.
+*/
+
+#include <vector>
+#include <string>
+#include <climits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "search_problem.hpp"
+
+enum class CardinalityEncoding { AUTO, SEQUENTIAL_COUNTER, TOTALIZER, SORTING_NETWORK };
+
+inline const char* cardinality_encoding_name(CardinalityEncoding encoding) {
+    switch (encoding) {
+        case CardinalityEncoding::AUTO: return "auto";
+        case CardinalityEncoding::SEQUENTIAL_COUNTER: return "sequential counter";
+        case CardinalityEncoding::TOTALIZER: return "totalizer";
+        case CardinalityEncoding::SORTING_NETWORK: return "sorting network";
+    }
+    return "unknown";
+}
+
+class CardinalityEncoder {
+    int last_variable;
+
+    // Batcher's odd-even merge sort over m (a power of two) wires; compare(i, j) puts the larger
+    // value on wire i
+    static void odd_even_merge_sort(int m, const std::function<void(int, int)>& compare) {
+        for (int p = 1; p < m; p <<= 1)
+            for (int k = p; k >= 1; k >>= 1)
+                for (int j = k % p; j + k < m; j += 2 * k)
+                    for (int i = 0; i < std::min(k, m - j - k); i++)
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) compare(i + j, i + j + k);
+    }
+
+    static int padded_size(int n) {
+        int m = 1;
+        while (m < n) m <<= 1;
+        return m;
+    }
+
+    // Output count of a totalizer node over n inputs, adding its clause count (and its children's)
+    static int totalizer_size(int n, int cap, bool upward, bool downward, size_t& clauses) {
+        if (n == 1) return 1;
+        int left = totalizer_size(n / 2, cap, upward, downward, clauses);
+        int right = totalizer_size(n - n / 2, cap, upward, downward, clauses);
+        int m = std::min(left + right, cap);
+        for (int a = 0; a <= left; a++)
+            for (int b = 0; b <= right; b++) {
+                if (upward && a + b >= 1 && a + b <= m) clauses++;
+                if (downward && a + b + 1 <= m) clauses++;
+            }
+        return m;
+    }
+
+    std::vector<int> totalizer_node(BigClauseList& clauses, const std::vector<int>& literals, size_t begin,
+                                    size_t end, int cap, bool upward, bool downward) {
+        if (end - begin == 1) return {literals[begin]};
+        size_t mid = begin + (end - begin) / 2;
+        std::vector<int> left = totalizer_node(clauses, literals, begin, mid, cap, upward, downward);
+        std::vector<int> right = totalizer_node(clauses, literals, mid, end, cap, upward, downward);
+        int la = int(left.size()), lb = int(right.size());
+        int m = std::min(la + lb, cap);
+        std::vector<int> out(m);
+        for (int& v : out) v = new_variable();
+        for (int a = 0; a <= la; a++) {
+            for (int b = 0; b <= lb; b++) {
+                // at least a on the left and b on the right: at least a + b here
+                if (upward && a + b >= 1 && a + b <= m) {
+                    BigClause clause;
+                    if (a > 0) clause.push_back(-left[a - 1]);
+                    if (b > 0) clause.push_back(-right[b - 1]);
+                    clause.push_back(out[a + b - 1]);
+                    clauses.push_back(clause);
+                }
+                // at most a on the left and b on the right: at most a + b here
+                if (downward && a + b + 1 <= m) {
+                    BigClause clause;
+                    if (a < la) clause.push_back(left[a]);
+                    if (b < lb) clause.push_back(right[b]);
+                    clause.push_back(-out[a + b]);
+                    clauses.push_back(clause);
+                }
+            }
+        }
+        return out;
+    }
+
+    // At most k (0 < k < n) of the literals, with s(i, j) = "at least j + 1 of the first i + 1"
+    void sequential_at_most(BigClauseList& clauses, const std::vector<int>& x, int k) {
+        int n = int(x.size());
+        std::vector<std::vector<int>> s(n - 1, std::vector<int>(k));
+        for (auto& row : s)
+            for (int& v : row) v = new_variable();
+        clauses.push_back({-x[0], s[0][0]});
+        for (int j = 1; j < k; j++) clauses.push_back({-s[0][j]});
+        for (int i = 1; i < n - 1; i++) {
+            clauses.push_back({-x[i], s[i][0]});
+            clauses.push_back({-s[i - 1][0], s[i][0]});
+            for (int j = 1; j < k; j++) {
+                clauses.push_back({-x[i], -s[i - 1][j - 1], s[i][j]});
+                clauses.push_back({-s[i - 1][j], s[i][j]});
+            }
+            clauses.push_back({-x[i], -s[i - 1][k - 1]});
+        }
+        clauses.push_back({-x[n - 1], -s[n - 2][k - 1]});
+    }
+
+    // The literals sorted: out[i] is (implies, or is implied by) "at least i + 1 are true"
+    std::vector<int> sorting_network(BigClauseList& clauses, const std::vector<int>& literals, bool upward,
+                                     bool downward) {
+        std::vector<int> wires(literals);
+        wires.resize(padded_size(int(literals.size())), 0);  // 0: constant false
+        odd_even_merge_sort(int(wires.size()), [&](int i, int j) {
+            int a = wires[i], b = wires[j];
+            if (a == 0 || b == 0) {
+                wires[i] = a ? a : b;
+                wires[j] = 0;
+                return;
+            }
+            int high = new_variable(), low = new_variable();  // a or b, a and b
+            if (upward) {
+                clauses.push_back({-a, high});
+                clauses.push_back({-b, high});
+                clauses.push_back({-a, -b, low});
+            }
+            if (downward) {
+                clauses.push_back({-high, a, b});
+                clauses.push_back({-low, a});
+                clauses.push_back({-low, b});
+            }
+            wires[i] = high;
+            wires[j] = low;
+        });
+        wires.resize(literals.size());
+        return wires;
+    }
+
+public:
+    // Auxiliary variables are numbered from last_used_variable + 1
+    explicit CardinalityEncoder(int last_used_variable) : last_variable(last_used_variable) {}
+
+    int new_variable() { return ++last_variable; }
+    // The largest variable in use, for DIMACS headers and solver models
+    int num_variables() const { return last_variable; }
+
+    // Estimated number of clauses an encoding takes for lo <= count <= hi over n literals
+    // (0 < lo or hi < n, lo <= hi)
+    static size_t estimated_clauses(CardinalityEncoding encoding, int n, int lo, int hi) {
+        bool upward = hi < n, downward = lo > 0;
+        switch (encoding) {
+            case CardinalityEncoding::SEQUENTIAL_COUNTER: {
+                auto counter = [n](size_t k) { return k + 1 + (n - 2) * (2 * k + 1); };
+                return (upward ? counter(hi) : 0) + (downward ? counter(n - lo) : 0);
+            }
+            case CardinalityEncoding::TOTALIZER: {
+                size_t clauses = 0;
+                totalizer_size(n, std::max(lo, upward ? hi + 1 : 0), upward, downward, clauses);
+                return clauses;
+            }
+            case CardinalityEncoding::SORTING_NETWORK: {
+                std::vector<char> real(padded_size(n), 0);
+                std::fill(real.begin(), real.begin() + n, 1);
+                size_t comparators = 0;
+                odd_even_merge_sort(int(real.size()), [&](int i, int j) {
+                    if (real[i] && real[j]) {
+                        comparators++;
+                    } else {
+                        real[i] |= real[j];
+                        real[j] = 0;
+                    }
+                });
+                return comparators * 3 * (int(upward) + int(downward));
+            }
+            case CardinalityEncoding::AUTO: break;
+        }
+        return 0;
+    }
+
+    static CardinalityEncoding choose(int n, int lo, int hi) {
+        CardinalityEncoding best = CardinalityEncoding::SEQUENTIAL_COUNTER;
+        for (CardinalityEncoding encoding : {CardinalityEncoding::TOTALIZER, CardinalityEncoding::SORTING_NETWORK})
+            if (estimated_clauses(encoding, n, lo, hi) < estimated_clauses(best, n, lo, hi)) best = encoding;
+        return best;
+    }
+
+    // Append clauses for lo <= (number of true literals) <= hi. A literal listed twice counts
+    // twice. Returns the encoding used (AUTO when the bounds need no auxiliary variables).
+    CardinalityEncoding encode(BigClauseList& clauses, const std::vector<int>& literals, int lo, int hi,
+                               CardinalityEncoding encoding = CardinalityEncoding::AUTO) {
+        int n = int(literals.size());
+        lo = std::max(lo, 0);
+        hi = std::min(hi, n);
+        if (lo > hi) {
+            clauses.push_back({});
+            return CardinalityEncoding::AUTO;
+        }
+        if (lo == 0 && hi == n) return CardinalityEncoding::AUTO;
+        if (hi == 0 || lo == n) {
+            for (int lit : literals) clauses.push_back({hi == 0 ? -lit : lit});
+            return CardinalityEncoding::AUTO;
+        }
+        if (encoding == CardinalityEncoding::AUTO) encoding = choose(n, lo, hi);
+
+        switch (encoding) {
+            case CardinalityEncoding::SEQUENTIAL_COUNTER: {
+                if (hi < n) sequential_at_most(clauses, literals, hi);
+                if (lo > 0) {
+                    std::vector<int> negated;
+                    for (int lit : literals) negated.push_back(-lit);
+                    sequential_at_most(clauses, negated, n - lo);
+                }
+                break;
+            }
+            case CardinalityEncoding::TOTALIZER:
+            case CardinalityEncoding::SORTING_NETWORK: {
+                std::vector<int> counts = encoding == CardinalityEncoding::TOTALIZER
+                    ? totalizer(clauses, literals, std::max(lo, hi < n ? hi + 1 : 0), hi < n, lo > 0)
+                    : sorting_network(clauses, literals, hi < n, lo > 0);
+                if (hi < n) clauses.push_back({-counts[hi]});
+                if (lo > 0) clauses.push_back({counts[lo - 1]});
+                break;
+            }
+            case CardinalityEncoding::AUTO: break;
+        }
+        return encoding;
+    }
+
+    CardinalityEncoding at_most(BigClauseList& clauses, const std::vector<int>& literals, int k,
+                                CardinalityEncoding encoding = CardinalityEncoding::AUTO) {
+        return encode(clauses, literals, 0, k, encoding);
+    }
+
+    CardinalityEncoding at_least(BigClauseList& clauses, const std::vector<int>& literals, int k,
+                                 CardinalityEncoding encoding = CardinalityEncoding::AUTO) {
+        return encode(clauses, literals, k, int(literals.size()), encoding);
+    }
+
+    // Totalizer outputs over the literals: out[i] for i < min(cap, n) stands for "at least i + 1
+    // are true". Upward clauses make a count force its output (so assuming -out[k] bounds the
+    // count by k); downward clauses make an output force the count.
+    std::vector<int> totalizer(BigClauseList& clauses, const std::vector<int>& literals, int cap = INT_MAX,
+                               bool upward = true, bool downward = true) {
+        if (literals.empty() || cap < 1) return {};
+        return totalizer_node(clauses, literals, 0, literals.size(), cap, upward, downward);
+    }
+};
+
+// The population of a set of cells: `alive` known live cells plus the true literals. Cells sharing
+// a variable each count.
+struct CellSum {
+    std::vector<int> literals;
+    int alive = 0;
+};
+
+// The cells of the problem where `mask` holds
+inline CellSum cell_sum(const SearchProblem& problem, const std::function<bool(Point)>& mask) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    CellSum sum;
+    for (int t = tlims.first; t <= tlims.second; t++) {
+        for (int y = ylims.first; y <= ylims.second; y++) {
+            for (int x = xlims.first; x <= xlims.second; x++) {
+                if (!mask(Point(x, y, t))) continue;
+                int v = problem.get_cell_value({x, y, t});
+                if (v == 1) sum.alive++;
+                else if (v >= 2) sum.literals.push_back(v - 1);
+            }
+        }
+    }
+    return sum;
+}
+
+inline CellSum generation_sum(const SearchProblem& problem, int t) {
+    return cell_sum(problem, [t](Point p) { return std::get<2>(p) == t; });
+}
+
+// lo <= population <= hi (INT_MAX for no upper bound)
+inline CardinalityEncoding add_population_bounds(BigClauseList& clauses, CardinalityEncoder& encoder,
+                                                 const CellSum& sum, int lo, int hi,
+                                                 CardinalityEncoding encoding = CardinalityEncoding::AUTO) {
+    if (hi < INT_MAX) hi -= sum.alive;
+    return encoder.encode(clauses, sum.literals, lo - sum.alive, hi, encoding);
+}
@@ -0,0 +1,595 @@
+#pragma once
+/*
+CdclSolver: a small in-tree incremental CDCL SAT solver (the IncrementalSolver interface), so that
+searches can run without an external solver process and keep their learned clauses between
+solves.
+
+MiniSat-style: two watched literals with blockers, first-UIP learning with local clause
+minimization, VSIDS decisions with phase saving (initially false, as most cells are dead), Luby
+restarts, periodic removal of the less useful half of the learned clauses (by glue, then
+activity), and assumptions as the first decision levels with final conflict analysis.
+
+It is meant for the incremental drivers and for small to medium problems; large one-shot
+searches are still best handed to kissat through solve().
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include "incremental_solver.hpp"
+
+class CdclSolver : public IncrementalSolver {
+public:
+    struct Stats {
+        uint64_t solves = 0;
+        uint64_t decisions = 0;
+        uint64_t propagations = 0;
+        uint64_t conflicts = 0;
+        uint64_t restarts = 0;
+        uint64_t learned = 0;        // learned clauses of two or more literals, ever
+        uint64_t deleted = 0;        // learned clauses removed by database reduction
+    };
+
+private:
+    // Internal literals: 2 * v for v, 2 * v + 1 for -v
+    static int lit(int dimacs) { return dimacs > 0 ? 2 * dimacs : -2 * dimacs + 1; }
+    static int var(int l) { return l >> 1; }
+    static constexpr int NO_REASON = -1;
+
+    // Clause literals live in one arena; a clause is the index of its header
+    struct ClauseData {
+        uint32_t start = 0;     // first literal in the arena
+        uint32_t size = 0;
+        bool learnt = false;
+        bool deleted = false;
+        int glue = 0;           // distinct decision levels when learned
+        float activity = 0;
+    };
+
+    struct Watch {
+        int clause;
+        int blocker;            // a literal of the clause; if true the clause need not be visited
+    };
+
+    bool ok = true;             // false once the clauses are unsatisfiable on their own
+    int num_vars = 0;
+    std::vector<ClauseData> clauses;
+    std::vector<int> arena;
+    size_t arena_garbage = 0;                // literals of deleted clauses still in the arena
+    std::vector<int> free_clauses;           // headers of deleted clauses
+    std::vector<std::vector<Watch>> watches; // by literal: clauses watching it
+    int num_learnt = 0;
+
+    std::vector<int8_t> assigns;        // by variable: 0 unassigned, 1 true, -1 false
+    std::vector<int> level;
+    std::vector<int> reason;
+    std::vector<bool> polarity;         // saved phase: true = positive
+    std::vector<double> activity;
+    std::vector<char> seen;
+    std::vector<uint64_t> level_stamp;  // by level, for counting distinct levels
+    uint64_t stamp = 0;
+    std::vector<int> minimized;
+    std::vector<int> trail;
+    std::vector<int> trail_lim;
+    size_t qhead = 0;
+
+    double var_inc = 1, clause_inc = 1;
+    double max_learnts = 0;
+
+    std::vector<int> assumptions;       // internal literals
+    std::vector<bool> model_values;     // by variable
+    std::vector<bool> failed_flags;     // by internal literal
+
+    // Max-heap of variables by activity
+    std::vector<int> heap;
+    std::vector<int> heap_index;        // by variable, -1 if not in the heap
+
+    Stats statistics;
+
+    // === Assignment ===
+
+    int8_t value_of(int l) const {
+        int8_t v = assigns[var(l)];
+        return (l & 1) ? -v : v;
+    }
+
+    int decision_level() const { return int(trail_lim.size()); }
+
+    void enqueue(int l, int from) {
+        int v = var(l);
+        assigns[v] = (l & 1) ? -1 : 1;
+        level[v] = decision_level();
+        reason[v] = from;
+        trail.push_back(l);
+    }
+
+    void cancel_until(int target) {
+        if (decision_level() <= target) return;
+        for (size_t i = trail.size(); i-- > size_t(trail_lim[target]);) {
+            int v = var(trail[i]);
+            assigns[v] = 0;
+            reason[v] = NO_REASON;
+            polarity[v] = !(trail[i] & 1);
+            heap_insert(v);
+        }
+        trail.resize(trail_lim[target]);
+        trail_lim.resize(target);
+        qhead = trail.size();
+    }
+
+    // === Variables ===
+
+    void ensure_variable(int v) {
+        int old_size = int(assigns.size());
+        if (v < old_size) return;
+        num_vars = v;
+        assigns.resize(v + 1, 0);
+        level.resize(v + 1, 0);
+        reason.resize(v + 1, NO_REASON);
+        polarity.resize(v + 1, false);
+        activity.resize(v + 1, 0);
+        seen.resize(v + 1, 0);
+        level_stamp.resize(v + 2, 0);
+        heap_index.resize(v + 1, -1);
+        watches.resize(2 * (v + 1));
+        for (int u = std::max(old_size, 1); u <= v; u++) heap_insert(u);
+    }
+
+    void bump_variable(int v) {
+        if ((activity[v] += var_inc) > 1e100) {
+            for (int u = 1; u <= num_vars; u++) activity[u] *= 1e-100;
+            var_inc *= 1e-100;
+        }
+        if (heap_index[v] >= 0) heap_up(heap_index[v]);
+    }
+
+    void bump_clause(ClauseData& c) {
+        if ((c.activity += float(clause_inc)) > 1e20f) {
+            for (ClauseData& d : clauses)
+                if (d.learnt) d.activity *= 1e-20f;
+            clause_inc *= 1e-20;
+        }
+    }
+
+    // === Heap ===
+
+    bool heap_before(int a, int b) const { return activity[a] > activity[b]; }
+
+    void heap_up(int i) {
+        int v = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!heap_before(v, heap[parent])) break;
+            heap[i] = heap[parent];
+            heap_index[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = v;
+        heap_index[v] = i;
+    }
+
+    void heap_down(int i) {
+        int v = heap[i];
+        int n = int(heap.size());
+        while (2 * i + 1 < n) {
+            int child = 2 * i + 1;
+            if (child + 1 < n && heap_before(heap[child + 1], heap[child])) child++;
+            if (!heap_before(heap[child], v)) break;
+            heap[i] = heap[child];
+            heap_index[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = v;
+        heap_index[v] = i;
+    }
+
+    void heap_insert(int v) {
+        if (heap_index[v] >= 0) return;
+        heap.push_back(v);
+        heap_index[v] = int(heap.size()) - 1;
+        heap_up(heap_index[v]);
+    }
+
+    int heap_pop() {
+        int v = heap[0];
+        heap_index[v] = -1;
+        int last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            heap_index[last] = 0;
+            heap_down(0);
+        }
+        return v;
+    }
+
+    // === Clauses ===
+
+    int* literals(int index) { return arena.data() + clauses[index].start; }
+    const int* literals(int index) const { return arena.data() + clauses[index].start; }
+
+    int store_clause(const std::vector<int>& lits, bool learnt) {
+        int index;
+        if (!free_clauses.empty()) {
+            index = free_clauses.back();
+            free_clauses.pop_back();
+            clauses[index] = ClauseData();
+        } else {
+            index = int(clauses.size());
+            clauses.emplace_back();
+        }
+        ClauseData& c = clauses[index];
+        c.start = uint32_t(arena.size());
+        c.size = uint32_t(lits.size());
+        c.learnt = learnt;
+        arena.insert(arena.end(), lits.begin(), lits.end());
+        watches[lits[0]].push_back({index, lits[1]});
+        watches[lits[1]].push_back({index, lits[0]});
+        if (learnt) num_learnt++;
+        return index;
+    }
+
+    // Whether the clause is the reason of its (true) first literal
+    bool locked(int index) const {
+        int first = literals(index)[0];
+        return reason[var(first)] == index && value_of(first) > 0;
+    }
+
+    // Move the literals of live clauses to a fresh arena; clause indices stay the same
+    void compact_arena() {
+        std::vector<int> fresh;
+        fresh.reserve(arena.size() - arena_garbage);
+        for (ClauseData& c : clauses) {
+            if (c.deleted) continue;
+            uint32_t start = uint32_t(fresh.size());
+            fresh.insert(fresh.end(), arena.begin() + c.start, arena.begin() + c.start + c.size);
+            c.start = start;
+        }
+        arena.swap(fresh);
+        arena_garbage = 0;
+    }
+
+    // Remove about half of the learned clauses: those with the highest glue, then lowest activity
+    void reduce_learnts() {
+        std::vector<int> learnts;
+        for (int i = 0; i < int(clauses.size()); i++)
+            if (clauses[i].learnt && !clauses[i].deleted) learnts.push_back(i);
+        std::sort(learnts.begin(), learnts.end(), [&](int a, int b) {
+            const ClauseData& ca = clauses[a];
+            const ClauseData& cb = clauses[b];
+            if (ca.glue != cb.glue) return ca.glue > cb.glue;
+            return ca.activity < cb.activity;
+        });
+        size_t removed = 0;
+        for (size_t i = 0; i < learnts.size() / 2; i++) {
+            ClauseData& c = clauses[learnts[i]];
+            if (c.glue <= 2 || locked(learnts[i])) continue;
+            c.deleted = true;
+            removed++;
+        }
+        if (removed == 0) return;
+        for (auto& ws : watches)
+            ws.erase(std::remove_if(ws.begin(), ws.end(), [&](const Watch& w) { return clauses[w.clause].deleted; }), ws.end());
+        for (int i = 0; i < int(clauses.size()); i++) {
+            ClauseData& c = clauses[i];
+            if (!c.deleted || c.size == 0) continue;
+            arena_garbage += c.size;
+            c.size = 0;
+            free_clauses.push_back(i);
+        }
+        num_learnt -= int(removed);
+        statistics.deleted += removed;
+        if (arena_garbage > arena.size() / 2) compact_arena();
+    }
+
+    // === Search ===
+
+    // Unit propagation; returns a conflicting clause or NO_REASON
+    int propagate() {
+        int conflict = NO_REASON;
+        while (qhead < trail.size()) {
+            int falsified = trail[qhead++] ^ 1;
+            statistics.propagations++;
+            std::vector<Watch>& ws = watches[falsified];
+            size_t i = 0, j = 0, n = ws.size();
+            while (i < n) {
+                Watch w = ws[i++];
+                if (value_of(w.blocker) > 0) {
+                    ws[j++] = w;
+                    continue;
+                }
+                int* c = literals(w.clause);
+                uint32_t size = clauses[w.clause].size;
+                if (c[0] == falsified) std::swap(c[0], c[1]);
+                int first = c[0];
+                Watch updated{w.clause, first};
+                if (first != w.blocker && value_of(first) > 0) {
+                    ws[j++] = updated;
+                    continue;
+                }
+                bool moved = false;
+                for (uint32_t k = 2; k < size; k++) {
+                    if (value_of(c[k]) >= 0) {
+                        std::swap(c[1], c[k]);
+                        watches[c[1]].push_back(updated);
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved) continue;
+                ws[j++] = updated;
+                if (value_of(first) < 0) {
+                    conflict = w.clause;
+                    qhead = trail.size();
+                    while (i < n) ws[j++] = ws[i++];
+                } else {
+                    enqueue(first, w.clause);
+                }
+            }
+            ws.resize(j);
+            if (conflict != NO_REASON) break;
+        }
+        return conflict;
+    }
+
+    // Whether literal l of the learned clause is implied by the others (its reason's other
+    // literals are all in the clause or fixed at level 0)
+    bool redundant(int l) const {
+        int r = reason[var(l)];
+        if (r == NO_REASON) return false;
+        const int* c = literals(r);
+        for (uint32_t k = 1; k < clauses[r].size; k++) {
+            int u = var(c[k]);
+            if (!seen[u] && level[u] > 0) return false;
+        }
+        return true;
+    }
+
+    // First-UIP conflict analysis. Fills `learnt` (asserting literal first) and returns the
+    // backtrack level.
+    int analyze(int conflict, std::vector<int>& learnt) {
+        learnt.assign(1, 0);
+        int pending = 0;
+        int p = -1;
+        size_t index = trail.size();
+        do {
+            ClauseData& c = clauses[conflict];
+            if (c.learnt) bump_clause(c);
+            const int* lits = literals(conflict);
+            for (uint32_t k = (p == -1 ? 0 : 1); k < c.size; k++) {
+                int q = lits[k];
+                int v = var(q);
+                if (seen[v] || level[v] == 0) continue;
+                bump_variable(v);
+                seen[v] = 1;
+                if (level[v] >= decision_level()) pending++;
+                else learnt.push_back(q);
+            }
+            while (!seen[var(trail[--index])]) {}
+            p = trail[index];
+            conflict = reason[var(p)];
+            seen[var(p)] = 0;
+            pending--;
+        } while (pending > 0);
+        learnt[0] = p ^ 1;
+
+        // local minimization
+        minimized.assign(1, learnt[0]);
+        for (size_t k = 1; k < learnt.size(); k++)
+            if (!redundant(learnt[k])) minimized.push_back(learnt[k]);
+        for (size_t k = 1; k < learnt.size(); k++) seen[var(learnt[k])] = 0;
+        learnt.swap(minimized);
+
+        int back = 0;
+        if (learnt.size() > 1) {
+            size_t max_k = 1;
+            for (size_t k = 2; k < learnt.size(); k++)
+                if (level[var(learnt[k])] > level[var(learnt[max_k])]) max_k = k;
+            std::swap(learnt[1], learnt[max_k]);
+            back = level[var(learnt[1])];
+        }
+        return back;
+    }
+
+    int glue(const std::vector<int>& lits) {
+        stamp++;
+        int distinct = 0;
+        for (int l : lits) {
+            uint64_t& s = level_stamp[level[var(l)]];
+            if (s != stamp) {
+                s = stamp;
+                distinct++;
+            }
+        }
+        return distinct;
+    }
+
+    // The assumptions responsible for assumption `p` being false (p is its negation)
+    void analyze_final(int p) {
+        failed_flags.assign(2 * (num_vars + 1), false);
+        failed_flags[p ^ 1] = true;
+        if (decision_level() == 0) return;
+        seen[var(p)] = 1;
+        for (size_t i = trail.size(); i-- > size_t(trail_lim[0]);) {
+            int v = var(trail[i]);
+            if (!seen[v]) continue;
+            if (reason[v] == NO_REASON) {
+                failed_flags[trail[i]] = true;
+            } else {
+                const int* c = literals(reason[v]);
+                for (uint32_t k = 1; k < clauses[reason[v]].size; k++)
+                    if (level[var(c[k])] > 0) seen[var(c[k])] = 1;
+            }
+            seen[v] = 0;
+        }
+        seen[var(p)] = 0;
+    }
+
+    int pick_branch() {
+        while (!heap.empty()) {
+            int v = heap_pop();
+            if (!assigns[v]) return polarity[v] ? 2 * v : 2 * v + 1;
+        }
+        return -1;
+    }
+
+    // Search until a result or `budget` conflicts (ERROR means: restart)
+    SolverStatus search(uint64_t budget) {
+        std::vector<int> learnt;
+        uint64_t conflicts = 0;
+        while (true) {
+            int conflict = propagate();
+            if (conflict != NO_REASON) {
+                statistics.conflicts++;
+                conflicts++;
+                if (decision_level() == 0) {
+                    ok = false;
+                    return SolverStatus::UNSAT;
+                }
+                int back = analyze(conflict, learnt);
+                int g = glue(learnt);
+                cancel_until(back);
+                if (learnt.size() == 1) {
+                    enqueue(learnt[0], NO_REASON);
+                } else {
+                    int index = store_clause(learnt, true);
+                    clauses[index].glue = g;
+                    bump_clause(clauses[index]);
+                    enqueue(learnt[0], index);
+                    statistics.learned++;
+                }
+                var_inc /= 0.95;
+                clause_inc /= 0.999;
+                continue;
+            }
+
+            if (conflicts >= budget) {
+                cancel_until(0);
+                return SolverStatus::ERROR;
+            }
+            if (num_learnt - int(trail.size()) >= max_learnts) {
+                reduce_learnts();
+                max_learnts *= 1.1;
+            }
+
+            int next = -1;
+            while (decision_level() < int(assumptions.size())) {
+                int a = assumptions[decision_level()];
+                if (value_of(a) > 0) {
+                    trail_lim.push_back(int(trail.size()));  // already true: empty level
+                } else if (value_of(a) < 0) {
+                    analyze_final(a ^ 1);
+                    return SolverStatus::UNSAT;
+                } else {
+                    next = a;
+                    break;
+                }
+            }
+            if (next == -1) {
+                next = pick_branch();
+                if (next == -1) {
+                    model_values.assign(num_vars + 1, false);
+                    for (int v = 1; v <= num_vars; v++) model_values[v] = assigns[v] > 0;
+                    return SolverStatus::SAT;
+                }
+                statistics.decisions++;
+            }
+            trail_lim.push_back(int(trail.size()));
+            enqueue(next, NO_REASON);
+        }
+    }
+
+    static double luby(double y, int x) {
+        int size = 1, seq = 0;
+        while (size < x + 1) {
+            seq++;
+            size = 2 * size + 1;
+        }
+        while (size - 1 != x) {
+            size = (size - 1) >> 1;
+            seq--;
+            x = x % size;
+        }
+        double result = 1;
+        while (seq-- > 0) result *= y;
+        return result;
+    }
+
+public:
+    CdclSolver() { ensure_variable(0); }
+
+    void reserve_variables(int n) override { ensure_variable(n); }
+    int new_variable() override {
+        ensure_variable(num_vars + 1);
+        return num_vars;
+    }
+    int num_variables() const override { return num_vars; }
+
+    using IncrementalSolver::add_clause;
+    void add_clause(const std::vector<int>& literals) override {
+        if (!ok) return;
+        std::vector<int> lits;
+        for (int dimacs : literals) {
+            if (dimacs == 0) throw std::runtime_error("CdclSolver: literal 0 in clause");
+            ensure_variable(std::abs(dimacs));
+            lits.push_back(lit(dimacs));
+        }
+        std::sort(lits.begin(), lits.end());
+        lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+        size_t kept = 0;
+        for (size_t k = 0; k < lits.size(); k++) {
+            if (k + 1 < lits.size() && lits[k + 1] == (lits[k] ^ 1)) return;  // tautology
+            int8_t v = value_of(lits[k]);
+            if (v > 0 && level[var(lits[k])] == 0) return;                   // satisfied
+            if (v < 0 && level[var(lits[k])] == 0) continue;                 // false literal
+            lits[kept++] = lits[k];
+        }
+        lits.resize(kept);
+
+        if (lits.empty()) {
+            ok = false;
+        } else if (lits.size() == 1) {
+            enqueue(lits[0], NO_REASON);
+            ok = propagate() == NO_REASON;
+        } else {
+            store_clause(lits, false);
+        }
+    }
+
+    SolverStatus solve(const std::vector<int>& assumption_literals = {}) override {
+        statistics.solves++;
+        model_values.clear();
+        failed_flags.clear();
+        if (!ok) return SolverStatus::UNSAT;
+        assumptions.clear();
+        for (int dimacs : assumption_literals) {
+            ensure_variable(std::abs(dimacs));
+            assumptions.push_back(lit(dimacs));
+        }
+        if (max_learnts == 0) max_learnts = std::max(1000.0, double(clauses.size()) / 3);
+
+        SolverStatus status = SolverStatus::ERROR;
+        for (int restart = 0; status == SolverStatus::ERROR; restart++) {
+            status = search(uint64_t(luby(2, restart) * 100));
+            if (status == SolverStatus::ERROR) statistics.restarts++;
+        }
+        cancel_until(0);
+        return status;
+    }
+
+    bool value(int literal) const override {
+        int v = std::abs(literal);
+        bool positive = v < int(model_values.size()) && model_values[v];
+        return literal > 0 ? positive : !positive;
+    }
+
+    bool failed(int literal) const override {
+        int l = lit(literal);
+        return l < int(failed_flags.size()) && failed_flags[l];
+    }
+
+    const Stats& stats() const { return statistics; }
+    int num_learned() const { return num_learnt; }
+};
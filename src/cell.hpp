@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "cell_group.hpp"
+#include "memory_stats.hpp"
 
 struct Cell {
     Point position;
@@ -10,6 +11,8 @@ struct Cell {
     bool state; // only relevant if known == true.
 };
 
+using CellList = std::vector<Cell, memory_stats::TrackedAllocator<Cell, memory_stats::AllocTag::CELLS>>;
+
 bool is_live(Cell c) {
     return c.known && c.state;
 }
@@ -0,0 +1,133 @@
+#pragma once
+/*
+Iterative deepening over generations on an incremental solver: instead of rebuilding and
+re-solving the whole problem for max_gen = 1, 2, 3, ..., one live solver is given the transitions
+into one more generation at a time, and the end-of-search constraints of each depth (e.g. "the
+last generation is a shifted copy of the first") are added behind an activation literal that is
+only assumed for that depth's solve. Everything learned at one depth carries over to the next.
+
+    SearchProblem problem(bounds);            // bounds reach the deepest generation to try
+    problem.add_entry(...);
+    problem.set_deduplicate(false);           // required, at the cost of the transition merge
+    problem.build();
+    CdclSolver solver;
+    solver.add_clause(generation_alive_clause(problem, 0));   // constraints for every depth
+    DeepeningResult found = iterative_deepening(problem, solver,
+        [](const SearchProblem& p, int depth) { return shifted_copy_constraints(p, depth, 1, 1); });
+
+Depth d means generations t_min .. t_min + d. The search stops at the first satisfiable depth, or
+early when a refutation did not need the depth's constraints: the transitions alone are then
+unsatisfiable, and deeper searches only add transitions.
+
+Transitions of a later generation could merge cells of earlier ones, so the problem is built
+without transition dedup (see SearchProblem::set_deduplicate). Each depth then carries more
+variables and clauses than a deduplicated build would; that is what reusing one solver costs,
+and when the depth is known a single solve of the deduplicated problem can be smaller.
+*/
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdexcept>
+#include "search_problem.hpp"
+#include "incremental_solver.hpp"
+#include "profiling.hpp"
+#include "logging.hpp"
+
+struct DeepeningResult {
+    SolverStatus status = SolverStatus::UNSAT;  // SAT at `depth`, or UNSAT at every depth up to it
+    int depth = 0;
+    SolverResult solution;                      // model over the problem variables when SAT
+};
+
+// End-of-search constraints for a depth, as clauses over problem literals (SAT variables)
+using DepthConstraints = std::function<BigClauseList(const SearchProblem& problem, int depth)>;
+
+// Clauses making cells a and b equal, for grid values (0 = dead, 1 = alive, >= 2 = variable + 1).
+// Two different known values give the empty clause.
+inline void add_equal_cells(BigClauseList& clauses, int a, int b) {
+    if (a < 2 && b < 2) {
+        if (a != b) clauses.push_back({});
+    } else if (a < 2 || b < 2) {
+        int known = a < 2 ? a : b, variable = a < 2 ? b - 1 : a - 1;
+        clauses.push_back({known ? variable : -variable});
+    } else if (a != b) {
+        clauses.push_back({-(a - 1), b - 1});
+        clauses.push_back({a - 1, -(b - 1)});
+    }
+}
+
+// Generation t_min + depth equals the first generation moved by (dx, dy), with dead cells outside
+// the bounds: an oscillator for dx = dy = 0, a spaceship otherwise
+inline BigClauseList shifted_copy_constraints(const SearchProblem& problem, int depth, int dx, int dy) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    int first = tlims.first, last = tlims.first + depth;
+    auto value = [&](int x, int y, int t) {
+        return in_limits(Point(x, y, t), problem.get_bounds()) ? problem.get_cell_value({x, y, t}) : 0;
+    };
+    BigClauseList clauses;
+    for (int y = ylims.first; y <= ylims.second; y++) {
+        for (int x = xlims.first; x <= xlims.second; x++) {
+            add_equal_cells(clauses, value(x, y, last), value(x - dx, y - dy, first));
+            // first-generation cells that would move out of the bounds must be dead
+            if (!in_limits(Point(x + dx, y + dy, last), problem.get_bounds()))
+                add_equal_cells(clauses, value(x, y, first), 0);
+        }
+    }
+    return clauses;
+}
+
+// "At least one cell of generation t is alive" (empty if a cell is known alive)
+inline BigClause generation_alive_clause(const SearchProblem& problem, int t) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    BigClause clause;
+    for (int y = ylims.first; y <= ylims.second; y++) {
+        for (int x = xlims.first; x <= xlims.second; x++) {
+            int v = problem.get_cell_value({x, y, t});
+            if (v == 1) return {};
+            if (v >= 2) clause.push_back(v - 1);
+        }
+    }
+    return clause;
+}
+
+inline DeepeningResult iterative_deepening(const SearchProblem& problem, IncrementalSolver& solver,
+                                           const DepthConstraints& end_constraints, int min_depth = 1) {
+    if (problem.deduplicates())
+        throw std::runtime_error("iterative_deepening: build the SearchProblem with set_deduplicate(false)");
+    profiling::ScopedTimer timer("iterative_deepening");
+
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    int max_depth = tlims.second - tlims.first;
+    solver.reserve_variables(problem.num_variables());
+
+    DeepeningResult result;
+    for (int depth = 1; depth <= max_depth; depth++) {
+        ClauseList transitions = problem.get_generation_clauses(tlims.first + depth);
+        solver.add_clauses(transitions);
+        if (depth < min_depth) continue;
+
+        profiling::ScopedTimer depth_timer("depth");
+        int act = solver.new_variable();
+        for (BigClause clause : end_constraints(problem, depth)) {
+            clause.push_back(-act);
+            solver.add_clause(clause);
+        }
+        result.depth = depth;
+        result.status = solver.solve({act});
+        depth_timer.stop();
+        logging::info() << "  Depth " << depth << ": " << solver_status_name(result.status) << " in "
+                        << format_duration(depth_timer.elapsed_ms()) << " (" << transitions.size()
+                        << " transition clauses added)";
+
+        if (result.status == SolverStatus::SAT) {
+            result.solution = solver.model(problem.num_variables());
+            break;
+        }
+        if (result.status == SolverStatus::ERROR) break;
+        bool needed_depth = solver.failed(act);
+        solver.add_clause({-act});  // retire this depth's constraints for good
+        if (!needed_depth) break;
+    }
+    return result;
+}
@@ -0,0 +1,122 @@
+#pragma once
+/*
+EncodingStats: shape statistics of a CNF encoding, for comparing encoders and search setups.
+
+clause_list_stats() covers any clause list (clause lengths, literal occurrences per variable).
+SearchProblem::encoding_stats() adds what only the transition encoding knows: how many
+transitions are unconstrained or fully known, how many distinct transition signatures remain
+after deduplication, clauses per generation, and which entry / cell group each variable came
+from. report() formats everything as text.
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include "sub_pattern.hpp"
+
+struct EncodingStats {
+    int num_variables = 0;
+    size_t num_clauses = 0;
+    std::map<int, size_t> clause_lengths;       // literals per clause -> clauses
+    std::vector<size_t> positive_occurrences;   // [var - 1] -> clauses containing var
+    std::vector<size_t> negative_occurrences;   // [var - 1] -> clauses containing -var
+
+    // Transition statistics (SearchProblem only). A transition is the step from a cell's
+    // neighborhood at t to the cell at t + 1.
+    size_t transitions = 0;             // outputs that follow the rules
+    size_t unconstrained = 0;           // outputs that do not follow the rules (no clauses)
+    size_t fully_known = 0;             // transitions with all ten cells known (no clauses)
+    size_t distinct_signatures = 0;     // distinct (center, neighbor multiset, output) among the rest
+    std::map<int, size_t> clauses_per_generation;      // output generation -> clauses
+    std::map<std::string, size_t> variables_by_origin; // "entry 1 / group 0", "shared" or "unreferenced" -> variables
+
+    explicit EncodingStats(int num_variables = 0)
+        : num_variables(num_variables), positive_occurrences(num_variables), negative_occurrences(num_variables) {}
+
+    void add_clause(const int* literals, int length) {
+        int len = 0;
+        for (int i = 0; i < length; i++) {
+            int lit = literals[i];
+            if (lit == 0) continue;  // Clause padding
+            len++;
+            size_t var = std::abs(lit) - 1;
+            if (var >= positive_occurrences.size()) {
+                positive_occurrences.resize(var + 1);
+                negative_occurrences.resize(var + 1);
+                num_variables = int(var + 1);
+            }
+            (lit > 0 ? positive_occurrences : negative_occurrences)[var]++;
+        }
+        clause_lengths[len]++;
+        num_clauses++;
+    }
+
+    void add_clause(const Clause& clause) { add_clause(clause.data(), MAX_CLAUSE_LEN); }
+    void add_clause(const BigClause& clause) { add_clause(clause.data(), int(clause.size())); }
+
+    // Variables bucketed by occurrence count: "0", "1", "2-3", "4-7", ...
+    std::vector<std::pair<std::string, size_t>> occurrence_histogram() const {
+        std::vector<std::pair<std::string, size_t>> buckets;
+        for (size_t v = 0; v < positive_occurrences.size(); v++) {
+            size_t n = positive_occurrences[v] + negative_occurrences[v];
+            size_t bucket = 0;
+            while (n >> bucket) bucket++;  // 0 -> 0, 1 -> 1, 2-3 -> 2, 4-7 -> 3, ...
+            while (buckets.size() <= bucket) {
+                size_t k = buckets.size();
+                size_t lo = k == 0 ? 0 : size_t(1) << (k - 1), hi = k == 0 ? 0 : (size_t(1) << k) - 1;
+                buckets.push_back({lo == hi ? std::to_string(lo) : std::to_string(lo) + "-" + std::to_string(hi), 0});
+            }
+            buckets[bucket].second++;
+        }
+        return buckets;
+    }
+
+    std::string report() const {
+        std::ostringstream out;
+        out << "CNF: " << num_variables << " variables, " << num_clauses << " clauses\n";
+
+        out << "Clause lengths:\n";
+        for (const auto& [len, n] : clause_lengths)
+            out << "  " << std::setw(4) << len << std::setw(12) << n << "\n";
+
+        size_t positive = 0, negative = 0, most = 0;
+        for (size_t v = 0; v < positive_occurrences.size(); v++) {
+            positive += positive_occurrences[v];
+            negative += negative_occurrences[v];
+            most = std::max(most, positive_occurrences[v] + negative_occurrences[v]);
+        }
+        out << "Literal occurrences per variable: mean " << std::fixed << std::setprecision(1)
+            << (num_variables ? double(positive + negative) / num_variables : 0.0) << ", max " << most
+            << " (" << positive << " positive, " << negative << " negative)\n";
+        for (const auto& [label, n] : occurrence_histogram())
+            if (n) out << "  " << std::setw(13) << label << std::setw(12) << n << "\n";
+
+        if (transitions + unconstrained > 0) {
+            out << "Transitions: " << transitions << " constrained, " << unconstrained << " unconstrained, "
+                << fully_known << " fully known, " << distinct_signatures << " distinct signatures\n";
+            out << "Clauses per generation:\n";
+            for (const auto& [t, n] : clauses_per_generation)
+                out << "  " << std::setw(4) << t << std::setw(12) << n << "\n";
+        }
+        if (!variables_by_origin.empty()) {
+            out << "Variables by origin:\n";
+            for (const auto& [origin, n] : variables_by_origin)
+                out << "  " << std::left << std::setw(24) << origin << std::right << std::setw(8) << n << "\n";
+        }
+        return out.str();
+    }
+};
+
+// Clause-level statistics of any encoding
+inline EncodingStats clause_list_stats(const ClauseList& clauses, int num_variables,
+                                       const BigClauseList& big_clauses = {}) {
+    EncodingStats stats(num_variables);
+    for (const Clause& clause : clauses) stats.add_clause(clause);
+    for (const BigClause& clause : big_clauses) stats.add_clause(clause);
+    return stats;
+}
@@ -0,0 +1,203 @@
+#pragma once
+/*
+Projected enumeration: all solutions that differ on a chosen set of cells (e.g. generation 0, or a
+catalyst region), rather than all models of the CNF. After each solution only the values of the
+projection variables are blocked, so models differing just in cells outside the projection (later
+generations, boundary or don't-care cells) are never produced twice.
+
+    CdclSolver solver;
+    solver.add_clauses(problem.get_clauses());
+    std::vector<int> projection = generation_variables(problem, 0);
+    enumerate_projected(solver, projection, problem.num_variables(),
+                        write_generation_stream(problem, 0, std::cout));
+
+Solutions are streamed to the callback as they are found; it returns false to stop. With a
+SupportMinimizer holding the clauses given to the solver, each solution is first shrunk to the
+projection literals the model needs: the dropped ones are don't-cares (every way of setting them is
+also a solution, with the same values elsewhere), and the shorter blocking clause rules them all
+out at once. Blocking clauses sit behind an activation literal that is retired at the end, so the
+solver can be reused.
+*/
+
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include <ostream>
+#include <functional>
+#include "search_problem.hpp"
+#include "incremental_solver.hpp"
+#include "solution.hpp"
+#include "profiling.hpp"
+#include "logging.hpp"
+
+// Variables of the cells where `mask` holds, each once, in (t, y, x) scan order
+inline std::vector<int> projection_variables(const SearchProblem& problem, const std::function<bool(Point)>& mask) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    std::vector<char> taken(problem.num_variables() + 1);
+    std::vector<int> variables;
+    for (int t = tlims.first; t <= tlims.second; t++) {
+        for (int y = ylims.first; y <= ylims.second; y++) {
+            for (int x = xlims.first; x <= xlims.second; x++) {
+                int v = problem.get_cell_value({x, y, t});
+                if (v < 2 || taken[v - 1] || !mask(Point(x, y, t))) continue;
+                taken[v - 1] = 1;
+                variables.push_back(v - 1);
+            }
+        }
+    }
+    return variables;
+}
+
+inline std::vector<int> generation_variables(const SearchProblem& problem, int t) {
+    return projection_variables(problem, [t](Point p) { return std::get<2>(p) == t; });
+}
+
+struct ProjectedSolution {
+    std::vector<int> literals;  // projection variable values (with minimization, only those needed)
+    SolverResult model;         // the model it came from, over the enumerated variables
+    size_t index = 0;           // 0 for the first solution
+};
+
+// Called for each solution as it is found; returns false to stop the enumeration
+using ProjectedCallback = std::function<bool(const ProjectedSolution& solution)>;
+
+// The clauses every model satisfies, indexed by literal, for shrinking a solution to its support.
+// Give it every clause the solver holds (blocking clauses aside), or minimization may drop
+// literals a clause it does not know about relies on.
+class SupportMinimizer {
+    std::vector<std::vector<int>> clauses;
+    std::vector<std::vector<int>> occurrences;  // clause indices, by 2 * var + (literal < 0)
+
+    static size_t slot(int lit) { return 2 * size_t(std::abs(lit)) + (lit < 0); }
+
+public:
+    void add_clause(std::vector<int> literals) {
+        std::sort(literals.begin(), literals.end());
+        literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+        for (int lit : literals)
+            if (std::binary_search(literals.begin(), literals.end(), -lit)) return;  // tautology
+        int index = int(clauses.size());
+        clauses.push_back(literals);
+        for (int lit : literals) {
+            if (slot(lit) >= occurrences.size()) occurrences.resize(slot(lit) + 2);
+            occurrences[slot(lit)].push_back(index);
+        }
+    }
+
+    void add_clauses(const ClauseList& list) {
+        std::vector<int> literals;
+        for (const Clause& clause : list) {
+            literals.clear();
+            for (int lit : clause)
+                if (lit != 0) literals.push_back(lit);
+            add_clause(literals);
+        }
+    }
+
+    void add_clauses(const BigClauseList& list) {
+        for (const BigClause& clause : list) add_clause(clause);
+    }
+
+    size_t size() const { return clauses.size(); }
+
+    // The literals of `cube` (all true under `values`, indexed by variable) that some clause has
+    // as its only true literal once the literals dropped before it are unassigned. Literals are
+    // tried in order, so earlier ones are the first to go.
+    std::vector<int> minimize(const std::vector<int>& cube, const std::vector<bool>& values) const {
+        std::vector<int> true_count(clauses.size());
+        for (size_t c = 0; c < clauses.size(); c++)
+            for (int lit : clauses[c])
+                if (size_t(std::abs(lit)) < values.size() && values[std::abs(lit)] == (lit > 0)) true_count[c]++;
+
+        std::vector<int> kept;
+        for (int lit : cube) {
+            const std::vector<int>* occ = slot(lit) < occurrences.size() ? &occurrences[slot(lit)] : nullptr;
+            bool needed = false;
+            if (occ)
+                for (int c : *occ) needed |= true_count[c] == 1;
+            if (needed) {
+                kept.push_back(lit);
+            } else if (occ) {
+                for (int c : *occ) true_count[c]--;
+            }
+        }
+        return kept;
+    }
+};
+
+struct EnumerationOptions {
+    size_t limit = 0;                             // stop after this many solutions (0 = all)
+    const SupportMinimizer* minimizer = nullptr;  // shrink blocking clauses to the support
+    std::vector<int> assumptions;                 // held for every solve
+};
+
+struct EnumerationResult {
+    SolverStatus status = SolverStatus::UNSAT;  // UNSAT once exhausted, SAT if stopped early, or ERROR
+    size_t solutions = 0;
+    size_t dont_cares = 0;                      // projection literals dropped by minimization
+};
+
+// Enumerate the distinct assignments of `projection` (SAT variables) over the solver's clauses.
+// Models passed to the callback cover variables 1..num_variables.
+inline EnumerationResult enumerate_projected(IncrementalSolver& solver, const std::vector<int>& projection,
+                                             int num_variables, const ProjectedCallback& on_solution,
+                                             const EnumerationOptions& options = {}) {
+    profiling::ScopedTimer timer("enumerate_projected");
+    solver.reserve_variables(num_variables);
+    int act = solver.new_variable();
+    std::vector<int> assumptions = options.assumptions;
+    assumptions.push_back(act);
+
+    EnumerationResult result;
+    ProjectedSolution solution;
+    std::vector<int> cube, blocking;
+    while (true) {
+        result.status = solver.solve(assumptions);
+        if (result.status != SolverStatus::SAT) break;
+
+        solution.model = solver.model(num_variables);
+        cube.clear();
+        for (int v : projection) cube.push_back(solver.value(v) ? v : -v);
+        if (options.minimizer) {
+            std::vector<bool> values(solver.num_variables() + 1);
+            for (int v = 1; v < int(values.size()); v++) values[v] = solver.value(v);
+            solution.literals = options.minimizer->minimize(cube, values);
+            result.dont_cares += cube.size() - solution.literals.size();
+        } else {
+            solution.literals = cube;
+        }
+        solution.index = result.solutions++;
+
+        blocking.assign(1, -act);
+        for (int lit : solution.literals) blocking.push_back(-lit);
+        solver.add_clause(blocking);
+
+        if (!on_solution(solution) || (options.limit && result.solutions >= options.limit)) {
+            result.status = SolverStatus::SAT;
+            break;
+        }
+    }
+    solver.add_clause({-act});  // retire the blocking clauses
+
+    timer.stop();
+    profiling::count("solutions", int64_t(result.solutions));
+    logging::info() << "  Enumeration: " << result.solutions << " solutions in "
+                    << format_duration(timer.elapsed_ms()) << " ("
+                    << (result.status == SolverStatus::UNSAT ? "complete" : "stopped") << ")";
+    return result;
+}
+
+// A callback writing generation t of each solution as RLE, one after another, each preceded by a
+// "#C solution <n>" line (and the number of don't-care cells, with minimization)
+inline ProjectedCallback write_generation_stream(const SearchProblem& problem, int t, std::ostream& out,
+                                                 size_t projection_size = 0) {
+    return [&problem, t, &out, projection_size](const ProjectedSolution& solution) {
+        out << "#C solution " << solution.index + 1;
+        if (projection_size > solution.literals.size())
+            out << " (" << projection_size - solution.literals.size() << " don't-care cells)";
+        out << "\n";
+        write_rle(out, extract_generation(problem, solution.model, t));
+        out.flush();
+        return bool(out);
+    };
+}
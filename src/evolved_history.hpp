@@ -0,0 +1,335 @@
+#pragma once
+/*
+EvolvedHistory: the immutable, evolved generations of a known pattern, shared between all
+KnownPatterns built from the same generation 0.
+
+shared_history() keeps a process-wide registry keyed by (RLE, rule, max_gen), where the RLE is
+the normalized encoding of generation 0 written by write_rle() plus the position of its bounding
+box. Asking twice for the same pattern evolves it once; KnownPatterns then hold a reference and
+their own shift. The registry only holds weak references, so a history is freed together with
+its last KnownPattern. Its lock only covers lookups and updates: the first caller for a key
+evolves (or loads) the history unlocked, and concurrent callers for the same key wait on its
+shared_future, so different keys are built in parallel.
+
+Optionally, histories are also cached on disk (set_history_cache_dir()): one file per key,
+named by a hash of the key, holding the generation planes in a versioned binary format:
+
+    CacheHeader | key bytes | padding to 8 | CachePlane[num_gens] | plane words (8-aligned)
+
+Files are memory-mapped on load and the planes are used in place, without copying; files are
+written to a temporary name and renamed, so concurrent processes never see a partial file.
+Files with another version, a different key or an inconsistent layout are ignored and rewritten.
+*/
+
+#include <map>
+#include <tuple>
+#include <mutex>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "geometry.hpp"
+#include "bitboard.hpp"
+#include "rle.hpp"
+
+class EvolvedHistory {
+    private:
+        // Planes owned by the history (empty when the planes live in a mapped file)
+        std::vector<BitPlane> owned;
+        // Keeps the mapped file alive while views point into it
+        std::shared_ptr<const void> mapping;
+        std::vector<BitPlaneView> views;
+
+    public:
+        // Bounding box of the live cells of all generations (EMPTY_LIMITS in x and y if there are none).
+        Bounds bounds = EMPTY_BOUNDS;
+
+        // planes[t] holds the live cells of generation t.
+        EvolvedHistory(std::vector<BitPlane> planes, Bounds bounds)
+            : owned(std::move(planes)), bounds(bounds) {
+            views.assign(owned.begin(), owned.end());
+        }
+
+        // Planes stored elsewhere, e.g. in a mapped file kept alive by `mapping`.
+        EvolvedHistory(std::vector<BitPlaneView> planes, std::shared_ptr<const void> mapping, Bounds bounds)
+            : mapping(std::move(mapping)), views(std::move(planes)), bounds(bounds) {}
+
+        // Views point into `owned`, so copies would dangle.
+        EvolvedHistory(const EvolvedHistory&) = delete;
+        EvolvedHistory& operator=(const EvolvedHistory&) = delete;
+
+        int num_generations() const { return int(views.size()); }
+        int max_gen() const { return int(views.size()) - 1; }
+        const BitPlaneView& generation(int t) const { return views[t]; }
+        bool is_mapped() const { return mapping != nullptr; }
+};
+
+// Dead cells kept around the working plane, so it only needs regrowing every few generations.
+const int EVOLUTION_MARGIN = 32;
+
+// Evolve generation 0 up to max_gen with the bitboard engine.
+inline std::shared_ptr<EvolvedHistory> evolve_history(const BitPlane& gen0, int max_gen) {
+    std::vector<BitPlane> planes;
+    Limits xlims = EMPTY_LIMITS, ylims = EMPTY_LIMITS;
+    auto record = [&](BitPlane live) {
+        int xmin, xmax, ymin, ymax;
+        if (live.live_bounds(xmin, xmax, ymin, ymax)) {
+            xlims = {std::min(xlims.first, xmin), std::max(xlims.second, xmax)};
+            ylims = {std::min(ylims.first, ymin), std::max(ylims.second, ymax)};
+        }
+        planes.push_back(std::move(live));
+    };
+
+    planes.reserve(std::max(max_gen, 0) + 1);
+    record(gen0.trimmed());
+    BitPlane work = planes[0];
+    for (int gen = 1; gen <= max_gen; gen++) {
+        if (!work.border_clear())
+            work = work.trimmed().padded(EVOLUTION_MARGIN);
+        work = life_step(work);
+        record(work.trimmed());
+    }
+    return std::make_shared<EvolvedHistory>(std::move(planes), Bounds(xlims, ylims, {0, max_gen}));
+}
+
+namespace evolved_history_detail {
+
+// (x0, y0 of the live bounding box, RLE with rule, max_gen)
+using Key = std::tuple<int, int, std::string, int>;
+
+using HistoryFuture = std::shared_future<std::shared_ptr<const EvolvedHistory>>;
+
+struct Entry {
+    std::weak_ptr<const EvolvedHistory> history;
+    HistoryFuture pending;  // valid while the first caller evolves or loads the history
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::map<Key, Entry> entries;
+    std::string cache_dir;  // empty: no disk cache
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// === Disk cache ===
+
+const char CACHE_MAGIC[8] = {'G', 'O', 'L', 'H', 'I', 'S', 'T', '\0'};
+const uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t key_size;
+    uint32_t num_gens;
+    int32_t bounds[6];  // xmin, xmax, ymin, ymax, tmin, tmax
+    uint32_t reserved;
+};
+
+struct CachePlane {
+    int32_t x0, y0, width, height, stride, reserved;
+    uint64_t offset;  // byte offset of the plane's words from the start of the file
+};
+
+inline size_t align8(size_t n) { return (n + 7) & ~size_t(7); }
+
+inline std::string key_string(const Key& key) {
+    auto& [x0, y0, rle, max_gen] = key;
+    return std::to_string(x0) + " " + std::to_string(y0) + " " + std::to_string(max_gen) + "\n" + rle;
+}
+
+// 64-bit FNV-1a
+inline uint64_t key_hash(const std::string& key) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+inline std::string cache_path(const std::string& dir, const std::string& key) {
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.hist", (unsigned long long)key_hash(key));
+    return dir + "/" + name;
+}
+
+// Map a cache file and check that it holds this key; nullptr if it is missing or unusable.
+inline std::shared_ptr<const EvolvedHistory> load_cached(const std::string& path, const std::string& key) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st;
+    if (fstat(fd, &st) < 0 || size_t(st.st_size) < sizeof(CacheHeader)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t size = st.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+    std::shared_ptr<const void> mapping(data, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+
+    const char* base = static_cast<const char*>(data);
+    CacheHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || header.version != CACHE_VERSION)
+        return nullptr;
+    size_t table = align8(sizeof(CacheHeader) + header.key_size);
+    if (header.key_size != key.size() || table + size_t(header.num_gens) * sizeof(CachePlane) > size ||
+            std::memcmp(base + sizeof(CacheHeader), key.data(), key.size()) != 0)
+        return nullptr;
+
+    std::vector<BitPlaneView> views(header.num_gens);
+    for (uint32_t t = 0; t < header.num_gens; t++) {
+        CachePlane entry;
+        std::memcpy(&entry, base + table + t * sizeof(CachePlane), sizeof(entry));
+        size_t bytes = size_t(entry.stride) * std::max(entry.height, 0) * sizeof(uint64_t);
+        if (entry.width < 0 || entry.height < 0 || entry.stride != (entry.width + 63) / 64 ||
+                entry.offset % 8 != 0 || entry.offset > size || bytes > size - entry.offset)
+            return nullptr;
+        BitPlaneView& view = views[t];
+        view.x0 = entry.x0;
+        view.y0 = entry.y0;
+        view.width = entry.width;
+        view.height = entry.height;
+        view.stride = entry.stride;
+        view.words = reinterpret_cast<const uint64_t*>(base + entry.offset);
+    }
+    const int32_t* b = header.bounds;
+    Bounds bounds({b[0], b[1]}, {b[2], b[3]}, {b[4], b[5]});
+    return std::make_shared<EvolvedHistory>(std::move(views), std::move(mapping), bounds);
+}
+
+// Write a history to the cache. Failures are ignored: the cache is only an optimization.
+inline void store_cached(const std::string& path, const std::string& key, const EvolvedHistory& history) {
+    CacheHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.key_size = key.size();
+    header.num_gens = history.num_generations();
+    auto [xlims, ylims, tlims] = history.bounds;
+    int32_t bounds[6] = {xlims.first, xlims.second, ylims.first, ylims.second, tlims.first, tlims.second};
+    std::memcpy(header.bounds, bounds, sizeof(bounds));
+
+    size_t table = align8(sizeof(CacheHeader) + key.size());
+    size_t offset = table + size_t(header.num_gens) * sizeof(CachePlane);
+    std::vector<CachePlane> entries(header.num_gens);
+    for (int t = 0; t < history.num_generations(); t++) {
+        const BitPlaneView& plane = history.generation(t);
+        entries[t] = {plane.x0, plane.y0, plane.width, plane.height, plane.stride, 0, offset};
+        offset += size_t(plane.stride) * plane.height * sizeof(uint64_t);
+    }
+
+    std::string tmp = path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return;
+        static const char zeros[8] = {};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(key.data(), key.size());
+        file.write(zeros, table - sizeof(CacheHeader) - key.size());
+        file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(CachePlane));
+        for (int t = 0; t < history.num_generations(); t++) {
+            const BitPlaneView& plane = history.generation(t);
+            file.write(reinterpret_cast<const char*>(plane.words), size_t(plane.stride) * plane.height * sizeof(uint64_t));
+        }
+        if (!file.good()) {
+            file.close();
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) std::remove(tmp.c_str());
+}
+
+}  // namespace evolved_history_detail
+
+// Enable the disk cache in `dir` (created if missing); an empty string disables it.
+inline void set_history_cache_dir(const std::string& dir) {
+    using namespace evolved_history_detail;
+    if (!dir.empty()) mkdir(dir.c_str(), 0777);
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.cache_dir = dir;
+}
+
+// The shared evolution of gen0 up to max_gen. It is only evolved if no live history matches and
+// the disk cache (if enabled) has no copy.
+inline std::shared_ptr<const EvolvedHistory> shared_history(const BitPlane& gen0, int max_gen) {
+    using namespace evolved_history_detail;
+    BitPlane live = gen0.trimmed();
+    Key key(live.x0, live.y0, plane_to_rle(live), max_gen);
+
+    Registry& reg = registry();
+    std::promise<std::shared_ptr<const EvolvedHistory>> promise;
+    std::unique_lock<std::mutex> lock(reg.mutex);
+    auto it = reg.entries.find(key);
+    if (it != reg.entries.end()) {
+        if (auto history = it->second.history.lock()) return history;
+        if (it->second.pending.valid()) {
+            // another thread is building this history: wait for it without the lock
+            HistoryFuture pending = it->second.pending;
+            lock.unlock();
+            return pending.get();
+        }
+    }
+    // Drop entries whose patterns have all been destroyed
+    for (auto e = reg.entries.begin(); e != reg.entries.end();) {
+        if (e->second.history.expired() && !e->second.pending.valid()) e = reg.entries.erase(e);
+        else ++e;
+    }
+    reg.entries[key].pending = promise.get_future().share();
+    std::string cache_dir = reg.cache_dir;
+    lock.unlock();
+
+    std::shared_ptr<const EvolvedHistory> history;
+    try {
+        std::string path, full_key;
+        if (!cache_dir.empty()) {
+            full_key = key_string(key);
+            path = cache_path(cache_dir, full_key);
+            history = load_cached(path, full_key);
+        }
+        if (!history) {
+            history = evolve_history(live, max_gen);
+            if (!path.empty()) store_cached(path, full_key, *history);
+        }
+    } catch (...) {
+        lock.lock();
+        reg.entries[key].pending = HistoryFuture();
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    Entry& entry = reg.entries[key];
+    entry.history = history;
+    entry.pending = HistoryFuture();
+    lock.unlock();
+    promise.set_value(history);
+    return history;
+}
+
+// Number of histories currently alive in the registry.
+inline size_t shared_history_count() {
+    using namespace evolved_history_detail;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (const auto& [key, entry] : reg.entries)
+        if (!entry.history.expired()) count++;
+    return count;
+}
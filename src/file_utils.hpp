@@ -0,0 +1,19 @@
+#pragma once
+#include <string>
+#include <fstream>
+#include <stdexcept>
+
+// Open a file for writing, refusing to replace an existing file unless overwrite is set.
+inline std::ofstream file_checks(const std::string& filename, bool overwrite){
+    if(!overwrite){
+        std::ifstream check(filename);
+        if(check.good()){
+            throw std::runtime_error("File already exists: " + filename);
+        }
+    }
+    std::ofstream file(filename);
+    if(!file.is_open()){
+        throw std::runtime_error("Could not open file for writing: " + filename);
+    }
+    return file;
+}
@@ -0,0 +1,398 @@
+#pragma once
+/*
+HashLife: a hash-consed quadtree universe for B3/S23 that advances patterns by large
+generation counts in time roughly logarithmic in the count (for regular patterns).
+
+QuadNode: a node at `level` covers a 2^level x 2^level square. Level 0 nodes are single cells.
+Nodes are canonical (structurally equal nodes share one pointer), so an empty square of each
+level is a unique node and results of advancing a node are cached by (node, step).
+
+HashLifeHistory: lazily materializes generations of a pattern as BitPlanes, restricted to a
+query window, for KnownPattern's HASHLIFE backend.
+*/
+
+#include <deque>
+#include <array>
+#include <functional>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "geometry.hpp"
+#include "bitboard.hpp"
+
+struct QuadNode {
+    const QuadNode* nw = nullptr;
+    const QuadNode* ne = nullptr;
+    const QuadNode* sw = nullptr;
+    const QuadNode* se = nullptr;
+    int level = 0;
+    bool alive = false;       // only meaningful at level 0
+    uint64_t population = 0;
+};
+
+class HashLife {
+private:
+    struct ChildrenKey {
+        const QuadNode* nw; const QuadNode* ne; const QuadNode* sw; const QuadNode* se;
+        bool operator==(const ChildrenKey& o) const {
+            return nw == o.nw && ne == o.ne && sw == o.sw && se == o.se;
+        }
+    };
+    struct ChildrenHash {
+        size_t operator()(const ChildrenKey& k) const {
+            size_t h = std::hash<const void*>{}(k.nw);
+            h ^= std::hash<const void*>{}(k.ne) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<const void*>{}(k.sw) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<const void*>{}(k.se) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+    struct StepKey {
+        const QuadNode* node; int step_log2;
+        bool operator==(const StepKey& o) const { return node == o.node && step_log2 == o.step_log2; }
+    };
+    struct StepHash {
+        size_t operator()(const StepKey& k) const {
+            return std::hash<const void*>{}(k.node) * 31 + k.step_log2;
+        }
+    };
+
+    std::deque<QuadNode> nodes;  // deque: node addresses stay valid as it grows
+    std::unordered_map<ChildrenKey, const QuadNode*, ChildrenHash> node_table;
+    std::unordered_map<StepKey, const QuadNode*, StepHash> step_cache;
+    std::vector<const QuadNode*> empty_nodes;  // empty_nodes[level]
+    const QuadNode* leaves[2];
+
+    // Advance a level-2 node (4x4) by one generation, returning its center 2x2 as a level-1 node.
+    const QuadNode* step_base(const QuadNode* n) {
+        bool cells[4][4];
+        for (int y = 0; y < 4; y++)
+            for (int x = 0; x < 4; x++)
+                cells[y][x] = cell(n, x, y);
+        const QuadNode* out[2][2];
+        for (int y = 1; y <= 2; y++) {
+            for (int x = 1; x <= 2; x++) {
+                int count = 0;
+                for (int dy = -1; dy <= 1; dy++)
+                    for (int dx = -1; dx <= 1; dx++)
+                        if ((dx || dy) && cells[y + dy][x + dx]) count++;
+                out[y - 1][x - 1] = leaf(count == 3 || (count == 2 && cells[y][x]));
+            }
+        }
+        return join(out[0][0], out[0][1], out[1][0], out[1][1]);
+    }
+
+    // The level-(L-1) square centered on a level-L node
+    const QuadNode* center(const QuadNode* n) {
+        return join(n->nw->se, n->ne->sw, n->sw->ne, n->se->nw);
+    }
+
+    // Centered squares straddling two or four children
+    const QuadNode* horizontal(const QuadNode* w, const QuadNode* e) {
+        return join(w->ne, e->nw, w->se, e->sw);
+    }
+    const QuadNode* vertical(const QuadNode* n, const QuadNode* s) {
+        return join(n->sw, n->se, s->nw, s->ne);
+    }
+
+public:
+    HashLife() {
+        for (int alive = 0; alive < 2; alive++) {
+            nodes.emplace_back();
+            QuadNode& leaf_node = nodes.back();
+            leaf_node.alive = alive;
+            leaf_node.population = alive;
+            leaves[alive] = &leaf_node;
+        }
+        empty_nodes.push_back(leaves[0]);
+    }
+
+    HashLife(const HashLife&) = delete;
+    HashLife& operator=(const HashLife&) = delete;
+
+    const QuadNode* leaf(bool alive) const { return leaves[alive ? 1 : 0]; }
+
+    // Canonical node with the given four children (all of the same level)
+    const QuadNode* join(const QuadNode* nw, const QuadNode* ne, const QuadNode* sw, const QuadNode* se) {
+        ChildrenKey key{nw, ne, sw, se};
+        auto it = node_table.find(key);
+        if (it != node_table.end()) return it->second;
+        nodes.emplace_back();
+        QuadNode& n = nodes.back();
+        n.nw = nw; n.ne = ne; n.sw = sw; n.se = se;
+        n.level = nw->level + 1;
+        n.population = nw->population + ne->population + sw->population + se->population;
+        node_table.emplace(key, &n);
+        return &n;
+    }
+
+    const QuadNode* empty(int level) {
+        while ((int)empty_nodes.size() <= level) {
+            const QuadNode* e = empty_nodes.back();
+            empty_nodes.push_back(join(e, e, e, e));
+        }
+        return empty_nodes[level];
+    }
+
+    // State of cell (x, y) relative to the node's upper-left corner
+    static bool cell(const QuadNode* n, int64_t x, int64_t y) {
+        while (n->level > 0) {
+            if (n->population == 0) return false;
+            int64_t half = int64_t(1) << (n->level - 1);
+            bool east = x >= half, south = y >= half;
+            if (east) x -= half;
+            if (south) y -= half;
+            n = south ? (east ? n->se : n->sw) : (east ? n->ne : n->nw);
+        }
+        return n->alive;
+    }
+
+    // Surround a node with empty space: the result is one level up, with n in its center.
+    const QuadNode* expand(const QuadNode* n) {
+        const QuadNode* e = empty(n->level - 1);
+        return join(join(e, e, e, n->nw), join(e, e, n->ne, e),
+                    join(e, n->sw, e, e), join(n->se, e, e, e));
+    }
+
+    // True if all live cells of a node (level >= 2) lie in its central half.
+    bool centered(const QuadNode* n) {
+        if (n->level < 2) return n->population == 0;
+        uint64_t inner = n->nw->se->population + n->ne->sw->population +
+                         n->sw->ne->population + n->se->nw->population;
+        return inner == n->population;
+    }
+
+    // The central half of a node (level >= 2) advanced by 2^step_log2 generations,
+    // as a node one level down. Requires step_log2 <= level - 2.
+    const QuadNode* step(const QuadNode* n, int step_log2) {
+        if (n->population == 0) return empty(n->level - 1);
+        StepKey key{n, step_log2};
+        auto it = step_cache.find(key);
+        if (it != step_cache.end()) return it->second;
+
+        const QuadNode* result;
+        if (n->level == 2) {
+            result = step_base(n);
+        } else {
+            // nine overlapping level-(L-1) squares
+            const QuadNode* n00 = n->nw;
+            const QuadNode* n01 = horizontal(n->nw, n->ne);
+            const QuadNode* n02 = n->ne;
+            const QuadNode* n10 = vertical(n->nw, n->sw);
+            const QuadNode* n11 = center(n);
+            const QuadNode* n12 = vertical(n->ne, n->se);
+            const QuadNode* n20 = n->sw;
+            const QuadNode* n21 = horizontal(n->sw, n->se);
+            const QuadNode* n22 = n->se;
+
+            bool full_speed = step_log2 == n->level - 2;
+            auto first = [&](const QuadNode* q) {
+                return full_speed ? step(q, step_log2 - 1) : center(q);
+            };
+            const QuadNode* r00 = first(n00); const QuadNode* r01 = first(n01); const QuadNode* r02 = first(n02);
+            const QuadNode* r10 = first(n10); const QuadNode* r11 = first(n11); const QuadNode* r12 = first(n12);
+            const QuadNode* r20 = first(n20); const QuadNode* r21 = first(n21); const QuadNode* r22 = first(n22);
+
+            int second = full_speed ? step_log2 - 1 : step_log2;
+            result = join(step(join(r00, r01, r10, r11), second),
+                          step(join(r01, r02, r11, r12), second),
+                          step(join(r10, r11, r20, r21), second),
+                          step(join(r11, r12, r21, r22), second));
+        }
+        step_cache.emplace(key, result);
+        return result;
+    }
+
+    // Build a node of the given level covering the square with upper-left (x, y) from a plane.
+    const QuadNode* from_plane(const BitPlane& plane, int64_t x, int64_t y, int level) {
+        int64_t size = int64_t(1) << level;
+        if (x >= plane.x0 + plane.width || y >= plane.y0 + plane.height ||
+                x + size <= plane.x0 || y + size <= plane.y0)
+            return empty(level);
+        if (level == 0) return leaf(plane.get(int(x), int(y)));
+        int64_t half = size / 2;
+        return join(from_plane(plane, x, y, level - 1), from_plane(plane, x + half, y, level - 1),
+                    from_plane(plane, x, y + half, level - 1), from_plane(plane, x + half, y + half, level - 1));
+    }
+
+    // Set the live cells of node n (upper-left at (x, y)) that fall inside out's rectangle.
+    static void write_to_plane(const QuadNode* n, int64_t x, int64_t y, BitPlane& out) {
+        if (n->population == 0) return;
+        int64_t size = int64_t(1) << n->level;
+        if (x >= out.x0 + out.width || y >= out.y0 + out.height ||
+                x + size <= out.x0 || y + size <= out.y0)
+            return;
+        if (n->level == 0) {
+            out.set(int(x), int(y), true);
+            return;
+        }
+        int64_t half = size / 2;
+        write_to_plane(n->nw, x, y, out);
+        write_to_plane(n->ne, x + half, y, out);
+        write_to_plane(n->sw, x, y + half, out);
+        write_to_plane(n->se, x + half, y + half, out);
+    }
+
+    // Bounding box of a node's live cells relative to its upper-left corner, as
+    // {xmin, xmax, ymin, ymax}. Memoized per node, so shared subtrees are visited once.
+    std::array<int64_t, 4> live_bounds(const QuadNode* n) {
+        if (n->population == 0) return {1, 0, 1, 0};
+        if (n->level == 0) return {0, 0, 0, 0};
+        auto it = bounds_cache.find(n);
+        if (it != bounds_cache.end()) return it->second;
+        int64_t half = int64_t(1) << (n->level - 1);
+        std::array<int64_t, 4> box = {1, 0, 1, 0};
+        const QuadNode* children[4] = {n->nw, n->ne, n->sw, n->se};
+        for (int i = 0; i < 4; i++) {
+            if (children[i]->population == 0) continue;
+            std::array<int64_t, 4> c = live_bounds(children[i]);
+            int64_t dx = (i & 1) ? half : 0, dy = (i & 2) ? half : 0;
+            if (box[0] > box[1]) {
+                box = {c[0] + dx, c[1] + dx, c[2] + dy, c[3] + dy};
+            } else {
+                box = {std::min(box[0], c[0] + dx), std::max(box[1], c[1] + dx),
+                       std::min(box[2], c[2] + dy), std::max(box[3], c[3] + dy)};
+            }
+        }
+        bounds_cache.emplace(n, box);
+        return box;
+    }
+
+    size_t node_count() const { return nodes.size(); }
+
+private:
+    std::unordered_map<const QuadNode*, std::array<int64_t, 4>> bounds_cache;
+};
+
+// A quadtree root positioned in the plane at a given generation.
+struct HashLifeState {
+    const QuadNode* root;
+    int64_t x0, y0;  // absolute position of the root's upper-left cell
+    int gen;
+};
+
+/*
+HashLifeHistory: generations 0..max_gen of a pattern, computed on demand.
+
+A generation is only evolved the first time a cell of it is queried, and only the query window
+(set with set_window, defaulting to the light cone of generation 0) is materialized as a BitPlane.
+Queries outside the window are answered by walking the quadtree, without materializing anything.
+*/
+class HashLifeHistory {
+private:
+    mutable HashLife universe;
+    HashLifeState start;
+    mutable HashLifeState cursor;  // most recently evolved state, reused for later generations
+    int max_gen;
+    Bounds window;
+    mutable std::map<int, BitPlane> materialized;
+
+    HashLifeState expanded(HashLifeState s) const {
+        int64_t margin = int64_t(1) << (s.root->level - 1);
+        return {universe.expand(s.root), s.x0 - margin, s.y0 - margin, s.gen};
+    }
+
+    // Advance a state by `gens` generations, one power of two at a time.
+    HashLifeState advance(HashLifeState s, int gens) const {
+        for (int j = 30; j >= 0; j--) {
+            if (!((gens >> j) & 1)) continue;
+            // Expand until the pattern sits in the central quarter and the node is big enough for 2^j.
+            while (s.root->level < j + 3 || !universe.centered(s.root))
+                s = expanded(s);
+            s = expanded(s);
+
+            int64_t offset = int64_t(1) << (s.root->level - 2);
+            s.root = universe.step(s.root, j);
+            s.x0 += offset; s.y0 += offset;
+            s.gen += 1 << j;
+        }
+        return s;
+    }
+
+    HashLifeState state_at(int gen) const {
+        HashLifeState s = gen >= cursor.gen ? cursor : start;
+        s = advance(s, gen - s.gen);
+        cursor = s;
+        return s;
+    }
+
+    BitPlane extract(const HashLifeState& s, const Limits& xlims, const Limits& ylims) const {
+        BitPlane plane(xlims.first, ylims.first, xlims.second - xlims.first + 1, ylims.second - ylims.first + 1);
+        HashLife::write_to_plane(s.root, s.x0, s.y0, plane);
+        return plane;
+    }
+
+public:
+    // Generation 0 is taken from a plane; max_gen bounds the generations that can be queried.
+    HashLifeHistory(const BitPlane& gen0, int max_gen) : max_gen(max_gen) {
+        int level = 1;
+        while ((int64_t(1) << level) < std::max(gen0.width, gen0.height)) level++;
+        start = {universe.from_plane(gen0, gen0.x0, gen0.y0, level), gen0.x0, gen0.y0, 0};
+        cursor = start;
+        window = Bounds({gen0.x0 - max_gen, gen0.x0 + gen0.width - 1 + max_gen},
+                        {gen0.y0 - max_gen, gen0.y0 + gen0.height - 1 + max_gen},
+                        {0, max_gen});
+    }
+
+    // Generation 0 built directly in the universe, e.g. by a file reader: make_start returns the
+    // root and the absolute position of its upper-left cell. The default window is the light cone
+    // of the live cells, so large patterns should be given a window before querying.
+    HashLifeHistory(const std::function<HashLifeState(HashLife&)>& make_start, int max_gen) : max_gen(max_gen) {
+        start = make_start(universe);
+        start.gen = 0;
+        cursor = start;
+        auto [xmin, xmax, ymin, ymax] = universe.live_bounds(start.root);
+        if (xmin > xmax) {
+            xmin = ymin = 0;
+            xmax = ymax = -1;
+        }
+        window = Bounds({int(start.x0 + xmin) - max_gen, int(start.x0 + xmax) + max_gen},
+                        {int(start.y0 + ymin) - max_gen, int(start.y0 + ymax) + max_gen},
+                        {0, max_gen});
+    }
+
+    HashLifeHistory(const HashLifeHistory&) = delete;
+    HashLifeHistory& operator=(const HashLifeHistory&) = delete;
+
+    // Restrict materialization to cells within `region` (unshifted pattern coordinates).
+    void set_window(Bounds region) {
+        window = region;
+        materialized.clear();
+    }
+
+    Bounds get_window() const { return window; }
+
+    // The materialized window of generation t (0 <= t <= max_gen)
+    const BitPlane& generation(int t) const {
+        if (t < 0 || t > max_gen)
+            throw std::out_of_range("HashLifeHistory: generation " + std::to_string(t) + " out of range");
+        auto it = materialized.find(t);
+        if (it == materialized.end()) {
+            auto [xlims, ylims, tlims] = window;
+            it = materialized.emplace(t, extract(state_at(t), xlims, ylims)).first;
+        }
+        return it->second;
+    }
+
+    bool get_state(int x, int y, int t) const {
+        if (t < 0 || t > max_gen) return false;
+        const BitPlane& plane = generation(t);
+        if (plane.in_plane(x, y)) return plane.get(x, y);
+        // Outside the window: look the cell up in the quadtree instead of materializing more.
+        HashLifeState s = state_at(t);
+        int64_t size = int64_t(1) << s.root->level;
+        if (x < s.x0 || y < s.y0 || x >= s.x0 + size || y >= s.y0 + size) return false;
+        return HashLife::cell(s.root, x - s.x0, y - s.y0);
+    }
+
+    // Population of generation t over the whole plane (not just the window)
+    uint64_t population(int t) const {
+        return state_at(t).root->population;
+    }
+
+    size_t node_count() const { return universe.node_count(); }
+};
@@ -0,0 +1,128 @@
+#pragma once
+/*
+TransitionHeatmap: where in space-time an encoding comes from. For every cell (x, y, t) of a
+SearchProblem it records the entry providing the cell, its variable before and after transition
+dedup, and what happened to the transition into it from generation t - 1:
+
+    unconstrained  no transition: first generation, or the cell does not follow the rules
+    known          all ten cells are known, so the transition gives no clauses
+    duplicate      same center, neighbor multiset and output as an earlier transition, so its
+                   clauses repeat that transition's
+    encoded        a transition with clauses of its own
+
+together with the number of clauses get_clauses() emits for it. Built by
+SearchProblem::transition_heatmap(); write_heatmap_csv() writes one row per cell:
+
+    x,y,t,entry,variable,raw_variable,status,clauses
+
+Variables use the grid convention: 0 = dead, 1 = alive, >= 2 = SAT variable + 1.
+*/
+
+#include <unordered_set>
+#include <functional>
+#include <array>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include "geometry.hpp"
+#include "file_utils.hpp"
+
+// Hash of a transition signature (center, sorted neighbors, output)
+struct TransitionSignatureHash {
+    size_t operator()(const std::array<int, 10>& signature) const {
+        size_t h = 0;
+        for (int v : signature) h ^= std::hash<int>{}(v) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+enum class TransitionStatus { UNCONSTRAINED, KNOWN, DUPLICATE, ENCODED };
+
+inline const char* transition_status_name(TransitionStatus status) {
+    switch (status) {
+        case TransitionStatus::UNCONSTRAINED: return "unconstrained";
+        case TransitionStatus::KNOWN: return "known";
+        case TransitionStatus::DUPLICATE: return "duplicate";
+        default: return "encoded";
+    }
+}
+
+struct HeatmapCell {
+    int entry = -1;        // SearchProblem entry providing the cell
+    int variable = 0;      // after transition dedup
+    int raw_variable = 0;  // before transition dedup
+    TransitionStatus status = TransitionStatus::UNCONSTRAINED;
+    int clauses = 0;       // clauses of the transition into this cell
+};
+
+class TransitionHeatmap {
+    Bounds bounds;
+    int sz_x, sz_y, sz_t;
+    std::vector<HeatmapCell> cells;
+    std::unordered_set<std::array<int, 10>, TransitionSignatureHash> signatures;  // center, sorted neighbors, output
+
+    size_t index(Point p) const {
+        auto [x, y, t] = p;
+        auto [xlims, ylims, tlims] = bounds;
+        return (size_t(t - tlims.first) * sz_y + (y - ylims.first)) * sz_x + (x - xlims.first);
+    }
+
+public:
+    explicit TransitionHeatmap(Bounds bounds) : bounds(bounds) {
+        auto [xlims, ylims, tlims] = bounds;
+        sz_x = xlims.second - xlims.first + 1;
+        sz_y = ylims.second - ylims.first + 1;
+        sz_t = tlims.second - tlims.first + 1;
+        cells.resize(size_t(sz_x) * sz_y * sz_t);
+    }
+
+    Bounds get_bounds() const { return bounds; }
+
+    // Precondition: in_limits(p, get_bounds())
+    HeatmapCell& at(Point p) { return cells[index(p)]; }
+    const HeatmapCell& at(Point p) const { return cells[index(p)]; }
+
+    // Classify the transition into p (ten_cells as for add_transition_clauses) that produced
+    // `clauses` clauses. Transitions must be recorded in the order they are encoded.
+    void record_transition(Point p, const std::array<int, 10>& ten_cells, int clauses) {
+        HeatmapCell& cell = at(p);
+        cell.clauses = clauses;
+        if (std::all_of(ten_cells.begin(), ten_cells.end(), [](int v) { return v < 2; })) {
+            cell.status = TransitionStatus::KNOWN;
+            return;
+        }
+        std::array<int, 10> signature = ten_cells;
+        std::swap(signature[4], signature[8]);  // center last among the neighborhood
+        std::sort(signature.begin(), signature.begin() + 8);
+        cell.status = signatures.insert(signature).second ? TransitionStatus::ENCODED : TransitionStatus::DUPLICATE;
+    }
+
+    size_t total_clauses() const {
+        size_t total = 0;
+        for (const HeatmapCell& cell : cells) total += cell.clauses;
+        return total;
+    }
+
+    // Clauses of each generation t (the transitions into t), indexed from the first generation
+    std::vector<size_t> clauses_per_generation() const {
+        std::vector<size_t> totals(sz_t, 0);
+        for (size_t i = 0; i < cells.size(); i++) totals[i / (size_t(sz_x) * sz_y)] += cells[i].clauses;
+        return totals;
+    }
+};
+
+inline void write_heatmap_csv(const TransitionHeatmap& heatmap, const std::string& filename, bool overwrite = false) {
+    std::ofstream file = file_checks(filename, overwrite);
+    auto [xlims, ylims, tlims] = heatmap.get_bounds();
+    file << "x,y,t,entry,variable,raw_variable,status,clauses\n";
+    for (int t = tlims.first; t <= tlims.second; t++) {
+        for (int y = ylims.first; y <= ylims.second; y++) {
+            for (int x = xlims.first; x <= xlims.second; x++) {
+                const HeatmapCell& cell = heatmap.at({x, y, t});
+                file << x << "," << y << "," << t << "," << cell.entry << "," << cell.variable << ","
+                     << cell.raw_variable << "," << transition_status_name(cell.status) << "," << cell.clauses << "\n";
+            }
+        }
+    }
+}
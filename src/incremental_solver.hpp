@@ -0,0 +1,126 @@
+#pragma once
+/*
+IncrementalSolver: a SAT solver that stays alive between solves, so that a search can add clauses
+as it goes and keep everything learned so far. Literals are DIMACS style (SAT variable v > 0 or
+its negation -v); variables are created as clauses mention them.
+
+    solver.add_clauses(problem.get_clauses());
+    int act = solver.new_variable();           // activation literal
+    solver.add_clause({-act, ...});            // clause only active while `act` is assumed
+    if (solver.solve({act}) == SolverStatus::UNSAT && solver.failed(act)) ...
+
+solve() returns SAT, UNSAT or ERROR. After SAT, value() reads the model; after UNSAT under
+assumptions, failed() tells which assumptions the refutation used (none means the clauses are
+unsatisfiable on their own). Assumptions only hold for the one solve() call.
+
+Implementations: CdclSolver (cdcl.hpp, in tree) and, built with -DHAVE_IPASIR and linked
+against a solver's IPASIR library (e.g. CaDiCaL's libcadical.a), IpasirSolver below.
+test/test_ipasir.cpp builds the adapter against a stub IPASIR library over CdclSolver.
+*/
+
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <initializer_list>
+#include "sub_pattern.hpp"
+#include "solver.hpp"
+
+class IncrementalSolver {
+public:
+    virtual ~IncrementalSolver() = default;
+
+    // Make sure variables 1..n exist, so that new_variable() numbers past them
+    virtual void reserve_variables(int n) = 0;
+    // A variable not used so far
+    virtual int new_variable() = 0;
+    virtual int num_variables() const = 0;
+
+    virtual void add_clause(const std::vector<int>& literals) = 0;
+    virtual SolverStatus solve(const std::vector<int>& assumptions = {}) = 0;
+
+    // Whether `literal` is true in the model of the last SAT solve()
+    virtual bool value(int literal) const = 0;
+    // Whether assumption `literal` is part of the refutation of the last UNSAT solve()
+    virtual bool failed(int literal) const = 0;
+
+    void add_clause(std::initializer_list<int> literals) { add_clause(std::vector<int>(literals)); }
+
+    // Transition clauses (0-padded) and arbitrary-length clauses
+    void add_clauses(const ClauseList& clauses) {
+        std::vector<int> literals;
+        for (const Clause& clause : clauses) {
+            literals.clear();
+            for (int lit : clause)
+                if (lit != 0) literals.push_back(lit);
+            add_clause(literals);
+        }
+    }
+
+    void add_clauses(const BigClauseList& clauses) {
+        for (const BigClause& clause : clauses) add_clause(clause);
+    }
+
+    // The model of the last SAT solve() over variables 1..n, in the form call_solver() returns
+    SolverResult model(int n) const {
+        SolverResult result;
+        result.status = SolverStatus::SAT;
+        for (int v = 1; v <= n; v++) result.solution.insert(value(v) ? v : -v);
+        return result;
+    }
+};
+
+#ifdef HAVE_IPASIR
+extern "C" {
+const char* ipasir_signature();
+void* ipasir_init();
+void ipasir_release(void* solver);
+void ipasir_add(void* solver, int32_t lit_or_zero);
+void ipasir_assume(void* solver, int32_t lit);
+int ipasir_solve(void* solver);
+int32_t ipasir_val(void* solver, int32_t lit);
+int ipasir_failed(void* solver, int32_t lit);
+}
+
+// Adapter for any solver implementing the IPASIR interface
+class IpasirSolver : public IncrementalSolver {
+    void* solver;
+    int max_variable = 0;
+
+public:
+    IpasirSolver() : solver(ipasir_init()) {}
+    ~IpasirSolver() override { ipasir_release(solver); }
+    IpasirSolver(const IpasirSolver&) = delete;
+    IpasirSolver& operator=(const IpasirSolver&) = delete;
+
+    static const char* signature() { return ipasir_signature(); }
+
+    void reserve_variables(int n) override { max_variable = std::max(max_variable, n); }
+    int new_variable() override { return ++max_variable; }
+    int num_variables() const override { return max_variable; }
+
+    void add_clause(const std::vector<int>& literals) override {
+        for (int lit : literals) {
+            max_variable = std::max(max_variable, std::abs(lit));
+            ipasir_add(solver, lit);
+        }
+        ipasir_add(solver, 0);
+    }
+    using IncrementalSolver::add_clause;
+
+    SolverStatus solve(const std::vector<int>& assumptions = {}) override {
+        for (int lit : assumptions) {
+            max_variable = std::max(max_variable, std::abs(lit));
+            ipasir_assume(solver, lit);
+        }
+        switch (ipasir_solve(solver)) {
+            case 10: return SolverStatus::SAT;
+            case 20: return SolverStatus::UNSAT;
+            default: return SolverStatus::ERROR;
+        }
+    }
+
+    bool value(int literal) const override { return ipasir_val(solver, literal) == literal; }
+    bool failed(int literal) const override { return ipasir_failed(solver, literal) != 0; }
+};
+#endif
@@ -1,82 +1,114 @@
 #include "known_pattern.hpp"
 
-KnownPattern::KnownPattern(std::string rle, int max_gen){
-    on_cells = std::set<Point>();
-    int x = 0;
-    int y = 0;
-    int max_x = 0;
-    int max_y = 0;
-    int i = 0;
-    int count = 0;
-    while(i < rle.size()){
-        char c = rle[i];
-        if(c == 'x' || c == '#') // skip header and comments.
-            while( i < rle.size() && rle[i] != '\n') i++;
-        if(c >= '0' && c <= '9'){
-            count = count * 10 + (c - '0');
-        } else {
-            if(count == 0) count = 1;
-            if(c == 'b'){
-                x += count;
-            } else if(c == 'o'){
-                for(int j = 0; j < count; j++){
-                    on_cells.insert(Point(x, y, 0));
-                    if(x > max_x) max_x = x;
-                    x += 1;
-                }
-            } else if(c == '$'){
-                y += count;
-                x = 0;
-            } else if(c == '!'){
-                break;
-            }
-            count = 0;
+KnownPattern::KnownPattern(std::string rle, int max_gen, EvolutionBackend backend)
+    : KnownPattern(parse_rle(rle), max_gen, backend) {}
+
+KnownPattern::KnownPattern(const BitPlane& gen0, int max_gen, EvolutionBackend backend)
+    : bounds(Bounds({gen0.x0, gen0.x0 + gen0.width - 1}, {gen0.y0, gen0.y0 + gen0.height - 1}, {0, max_gen})),
+      shift(0,0,0)
+{
+    init(gen0, max_gen, backend);
+}
+
+KnownPattern::KnownPattern(const std::set<Point>& on_cells, int max_gen, EvolutionBackend backend)
+    : bounds(EMPTY_BOUNDS), shift(0,0,0)
+{
+    std::pair<int, int> xlims = EMPTY_LIMITS, ylims = EMPTY_LIMITS;
+    for(auto [x, y, t] : on_cells){
+        if(t != 0) continue;
+        if(xlims.first > xlims.second){
+            xlims = {x, x};
+            ylims = {y, y};
         }
-        i++;
+        xlims = {std::min(xlims.first, x), std::max(xlims.second, x)};
+        ylims = {std::min(ylims.first, y), std::max(ylims.second, y)};
+    }
+    bounds = Bounds(xlims, ylims, {0, max_gen});
+    BitPlane gen0(xlims.first, ylims.first, xlims.second - xlims.first + 1, ylims.second - ylims.first + 1);
+    for(auto [x, y, t] : on_cells){
+        if(t == 0) gen0.set(x, y, true);
     }
-    bounds = Bounds({0, max_x}, {0, y}, {0, max_gen});
-    shift = Point(0,0,0);
-    for (int gen = 1; gen <= max_gen; gen++){
-        add_next_gen(*this, gen);
+    init(gen0, max_gen, backend);
+}
+
+KnownPattern::KnownPattern(const std::set<Point>& on_cells, Bounds bounds)
+    : bounds(bounds), shift(0,0,0)
+{
+    auto [xlims, ylims, tlims] = bounds;
+    int width = xlims.second - xlims.first + 1;
+    int height = ylims.second - ylims.first + 1;
+    std::vector<BitPlane> planes(std::max(tlims.second + 1, 0), BitPlane(xlims.first, ylims.first, width, height));
+    for(auto [x, y, t] : on_cells){
+        if(in_limits({x, y, t}, bounds) && t >= 0) planes[t].set(x, y, true);
+    }
+    for(auto& plane : planes){
+        plane = plane.trimmed();
+    }
+    history = std::make_shared<EvolvedHistory>(std::move(planes), bounds);
+}
+
+// Set up generation storage from generation 0. bounds must already cover gen0's live cells.
+void KnownPattern::init(const BitPlane& gen0, int max_gen, EvolutionBackend backend){
+    if(backend == EvolutionBackend::HASHLIFE){
+        // Generations are evolved lazily, so bounds are the light cone of generation 0.
+        hashlife = std::make_shared<HashLifeHistory>(gen0, max_gen);
+        auto [xlims, ylims, tlims] = bounds;
+        bounds = Bounds({xlims.first - max_gen, xlims.second + max_gen},
+                        {ylims.first - max_gen, ylims.second + max_gen}, {0, max_gen});
+    } else {
+        set_history(shared_history(gen0, max_gen));
     }
-};
+}
 
 void update_bounds(std::pair<int, int>& bounds, int val){
     if(val < bounds.first) bounds.first = val;
     if(val > bounds.second) bounds.second = val;
 }
 
-// naive implementation of next generation computation.
-void KnownPattern::add_next_gen(KnownPattern& pattern, int gen){
-    std::set<Point> new_on_cells;
-    std::pair<int, int> new_xbounds = {std::get<0>(pattern.bounds).first, std::get<0>(pattern.bounds).second};
-    std::pair<int, int> new_ybounds = {std::get<1>(pattern.bounds).first, std::get<1>(pattern.bounds).second};
-    for(int x = std::get<0>(pattern.bounds).first - 1; x <= std::get<0>(pattern.bounds).second + 1; x++){
-        for(int y = std::get<1>(pattern.bounds).first - 1; y <= std::get<1>(pattern.bounds).second + 1; y++){
-            Point p = Point(x,y,gen);
-            int live_neighbors = 0;
-            for(int dy = -1; dy <= 1; dy++){
-                for(int dx = -1; dx <= 1; dx++){
-                    if(dx == 0 && dy == 0) continue;
-                    Point neighbor = Point(x + dx, y + dy, gen - 1);
-                    if(pattern.get_state(neighbor)){
-                        live_neighbors++;
-                    }
-                }
-            }
-            bool currently_alive = pattern.get_state({x, y, gen - 1});
-            if( (currently_alive && live_neighbors == 2) || (live_neighbors == 3)){
-                new_on_cells.insert(p);
-                update_bounds(new_xbounds, x);
-                update_bounds(new_ybounds, y);
-            }
-        }
+// Use an evolved history, growing bounds to cover every live cell in it.
+void KnownPattern::set_history(std::shared_ptr<const EvolvedHistory> evolved){
+    history = std::move(evolved);
+    auto [hx, hy, ht] = history->bounds;
+    std::pair<int, int> new_xbounds = std::get<0>(bounds);
+    std::pair<int, int> new_ybounds = std::get<1>(bounds);
+    if(hx.first <= hx.second){
+        update_bounds(new_xbounds, hx.first);
+        update_bounds(new_xbounds, hx.second);
+        update_bounds(new_ybounds, hy.first);
+        update_bounds(new_ybounds, hy.second);
     }
-    // more efficient to extend?
-    for(auto p : new_on_cells){
-        pattern.on_cells.insert(p);
+    bounds = Bounds(new_xbounds, new_ybounds, {0, history->max_gen()});
+}
+
+BitPlane KnownPattern::get_generation(int gen) const {
+    auto [xlims, ylims, tlims] = get_bounds();
+    return get_generation(gen, xlims, ylims);
+}
+
+BitPlane KnownPattern::get_generation(int gen, Limits xlims, Limits ylims) const {
+    auto [dx, dy, dt] = shift;
+    int width = xlims.second - xlims.first + 1;
+    int height = ylims.second - ylims.first + 1;
+    int t = gen - dt;
+    BitPlane plane;
+    if(hashlife){
+        plane = BitPlane(xlims.first - dx, ylims.first - dy, width, height);
+        for(int y = 0; y < height; y++)
+            for(int x = 0; x < width; x++)
+                if(hashlife->get_state(plane.x0 + x, plane.y0 + y, t)) plane.set(plane.x0 + x, plane.y0 + y, true);
+    } else if(history && t >= 0 && t < history->num_generations()){
+        plane = history->generation(t).cropped(xlims.first - dx, ylims.first - dy, width, height);
+    } else {
+        plane = BitPlane(xlims.first - dx, ylims.first - dy, width, height);
+        if(!history && !hashlife){
+            for(auto [x, y, cell_t] : on_cells)
+                if(cell_t == t && x >= plane.x0 && x < plane.x0 + width && y >= plane.y0 && y < plane.y0 + height)
+                    plane.set(x, y, true);
+        }
     }
-    pattern.bounds = Bounds(new_xbounds, new_ybounds, {0, gen});
+    plane.x0 += dx;
+    plane.y0 += dy;
+    return plane;
 }
 
 void KnownPattern::print_gen(int gen) const {
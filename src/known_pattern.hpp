@@ -2,34 +2,87 @@
 /*
 KnownPattern: A fully-determined pattern where all cell states are known.
 Inherits from SubPattern for use in SearchProblem composition.
+
+Two evolution backends:
+- BITBOARD: every generation up to max_gen is evolved up front (the default). The evolved
+  generations are an immutable EvolvedHistory shared by every KnownPattern built from the same
+  generation 0 and max_gen, so copies and reuses under other shifts cost only a reference.
+- HASHLIFE: generations are evolved on demand with a quadtree, and only the window passed to
+  restrict_queries() is materialized. Suited to long max_gen where few generations are queried.
+
+A default-constructed pattern can still be filled in by hand through on_cells and bounds, as
+before the backends; its cells are looked up in the set.
 */
 
 #include <set>
 #include <utility>
 #include <algorithm>
 #include <string>
+#include <vector>
+#include <memory>
 #include "sub_pattern.hpp"
+#include "bitboard.hpp"
+#include "evolved_history.hpp"
+#include "hashlife.hpp"
+#include "rle.hpp"
+
+enum class EvolutionBackend {
+    BITBOARD,
+    HASHLIFE
+};
 
 class KnownPattern : public SubPattern {
     private:
-        void add_next_gen(KnownPattern& pattern, int gen);
+        // Set only for the BITBOARD backend (no shift applied); shared with other patterns.
+        std::shared_ptr<const EvolvedHistory> history;
+        // Set only for the HASHLIFE backend; shared between copies of the pattern.
+        std::shared_ptr<HashLifeHistory> hashlife;
+        void init(const BitPlane& gen0, int max_gen, EvolutionBackend backend);
+        void set_history(std::shared_ptr<const EvolvedHistory> evolved);
     public:
+        // Live cells of all generations (no shift applied) of a pattern filled in by hand. Only
+        // used when there is no evolved history, so it stays empty for the evolving constructors.
         std::set<Point> on_cells;
         Bounds bounds; // xlimits, ylimits, tlimits (no shift applied)
         Point shift;
-        
+
         // Get the state (alive/dead) at a position
         bool get_state(Point p) const override {
-            // on_cells has origin (0,0,0), but pattern has been shifted by 'shift'.
-            return on_cells.find(p - shift) != on_cells.end();
+            // generations have origin (0,0,0), but pattern has been shifted by 'shift'.
+            auto [x, y, t] = p - shift;
+            if (history) {
+                if (t < 0 || t >= history->num_generations()) return false;
+                return history->generation(t).get(x, y);
+            }
+            if (hashlife) return hashlife->get_state(x, y, t);
+            return on_cells.count({x, y, t}) > 0;
         }
 
+        // The shared bitboard history (null for the HASHLIFE backend and empty patterns).
+        std::shared_ptr<const EvolvedHistory> get_history() const { return history; }
+
+        // Cells of generation `gen` within the given limits (shift applied), as a plane.
+        // A single row is BitPlane get_generation(gen, {x_begin, x_end}, {y, y}).
+        BitPlane get_generation(int gen, Limits xlims, Limits ylims) const;
+        // Generation `gen` over the whole (shifted) bounds, e.g. for write_rle_file.
+        BitPlane get_generation(int gen) const;
+
         void shift_by(Point rel_shift){
             this->shift = this->shift + rel_shift;
         }
 
-        KnownPattern() : on_cells(), bounds(EMPTY_BOUNDS), shift(0,0,0) {}
-        KnownPattern(std::string rle, int max_gen);
+        KnownPattern() : bounds(EMPTY_BOUNDS), shift(0,0,0) {}
+        KnownPattern(std::string rle, int max_gen, EvolutionBackend backend = EvolutionBackend::BITBOARD);
+        // Evolve generation 0 given as a plane, e.g. from read_rle_file().
+        KnownPattern(const BitPlane& gen0, int max_gen, EvolutionBackend backend = EvolutionBackend::BITBOARD);
+        // Use an existing lazy history (HASHLIFE backend), e.g. from load_macrocell().
+        // Bounds are the history's current window.
+        KnownPattern(std::shared_ptr<HashLifeHistory> history)
+            : hashlife(std::move(history)), bounds(hashlife->get_window()), shift(0,0,0) {}
+        // Evolve generation 0 given by the t == 0 points of on_cells.
+        KnownPattern(const std::set<Point>& on_cells, int max_gen, EvolutionBackend backend = EvolutionBackend::BITBOARD);
+        // Take every generation as given (no evolution): on_cells lists live cells of all generations in bounds.
+        KnownPattern(const std::set<Point>& on_cells, Bounds bounds);
         void print_gen(int gen) const;
 
         // SubPattern interface implementation
@@ -41,6 +94,11 @@ class KnownPattern : public SubPattern {
             // No-op: KnownPattern is already fully determined
         }
 
+        void restrict_queries(Bounds region) override {
+            // Only the HASHLIFE backend materializes lazily; the bitboard history is already complete.
+            if (hashlife) hashlife->set_window(region - shift);
+        }
+
         int num_variables() const override {
             return 0;  // No variables in a known pattern
         }
@@ -0,0 +1,177 @@
+#pragma once
+/*
+Logging: leveled messages to a replaceable sink. Library code logs its per-phase lines here
+instead of writing to std::cout, so callers running many small searches can silence or
+redirect them.
+
+    logging::info() << "  Build phase: " << ms << " ms";      // formatted only if INFO is enabled
+
+    logging::set_level(logging::Level::WARNING);              // quiet mode: drop INFO and DEBUG
+    logging::set_sink(std::make_shared<logging::NullSink>());  // or discard everything
+    logging::set_sink(std::make_shared<logging::BufferedFileSink>("search.log"));
+    logging::set_sink(std::make_shared<logging::CallbackSink>(
+        [](logging::Level level, const std::string& message) { ... }));
+
+The default sink writes each message as a line to std::cout at level INFO and above. Messages
+below the level, or sent to a NullSink, are not formatted at all, though their operands are
+still evaluated; the library's lines that read /proc for RSS check enabled(Level::INFO) first.
+Sinks are called under a lock, so they need not be thread-safe themselves.
+*/
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include "file_utils.hpp"
+
+namespace logging {
+
+enum class Level { DEBUG, INFO, WARNING, ERROR, OFF };
+
+inline const char* level_name(Level level) {
+    switch (level) {
+        case Level::DEBUG: return "DEBUG";
+        case Level::INFO: return "INFO";
+        case Level::WARNING: return "WARNING";
+        case Level::ERROR: return "ERROR";
+        default: return "OFF";
+    }
+}
+
+class Sink {
+public:
+    virtual ~Sink() = default;
+    // One message, without a trailing newline
+    virtual void write(Level level, const std::string& message) = 0;
+    virtual void flush() {}
+    // True if messages are dropped, so they need not be formatted
+    virtual bool discards() const { return false; }
+};
+
+class StdoutSink : public Sink {
+public:
+    void write(Level, const std::string& message) override { std::cout << message << "\n"; }
+    void flush() override { std::cout.flush(); }
+};
+
+class NullSink : public Sink {
+public:
+    void write(Level, const std::string&) override {}
+    bool discards() const override { return true; }
+};
+
+class CallbackSink : public Sink {
+    std::function<void(Level, const std::string&)> callback;
+
+public:
+    explicit CallbackSink(std::function<void(Level, const std::string&)> callback) : callback(std::move(callback)) {}
+    void write(Level level, const std::string& message) override { callback(level, message); }
+};
+
+// Appends lines to a file, writing them out once `buffer_bytes` have accumulated, on flush(),
+// and on destruction.
+class BufferedFileSink : public Sink {
+    std::ofstream file;
+    std::string buffer;
+    size_t buffer_bytes;
+
+public:
+    explicit BufferedFileSink(const std::string& filename, bool overwrite = true, size_t buffer_bytes = 1 << 16)
+        : file(file_checks(filename, overwrite)), buffer_bytes(buffer_bytes) {
+        buffer.reserve(buffer_bytes);
+    }
+
+    ~BufferedFileSink() override { flush(); }
+
+    void write(Level, const std::string& message) override {
+        buffer += message;
+        buffer += '\n';
+        if (buffer.size() >= buffer_bytes) flush();
+    }
+
+    void flush() override {
+        file.write(buffer.data(), buffer.size());
+        file.flush();
+        buffer.clear();
+    }
+};
+
+namespace detail {
+
+struct State {
+    std::atomic<int> level{int(Level::INFO)};
+    std::atomic<bool> discarding{false};  // the sink is a NullSink
+    std::mutex mutex;                     // guards `sink` and calls into it
+    std::shared_ptr<Sink> sink = std::make_shared<StdoutSink>();
+};
+
+inline State& state() {
+    static State instance;
+    return instance;
+}
+
+}  // namespace detail
+
+// Messages below `level` are dropped; Level::OFF drops everything.
+inline void set_level(Level level) { detail::state().level.store(int(level), std::memory_order_relaxed); }
+inline Level get_level() { return Level(detail::state().level.load(std::memory_order_relaxed)); }
+
+// Replace the sink (nullptr restores the default stdout sink). Returns the previous one.
+inline std::shared_ptr<Sink> set_sink(std::shared_ptr<Sink> sink) {
+    detail::State& s = detail::state();
+    if (!sink) sink = std::make_shared<StdoutSink>();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.discarding.store(sink->discards(), std::memory_order_relaxed);
+    std::swap(s.sink, sink);
+    return sink;
+}
+
+inline bool enabled(Level level) {
+    const detail::State& s = detail::state();
+    return level != Level::OFF && int(level) >= s.level.load(std::memory_order_relaxed) &&
+           !s.discarding.load(std::memory_order_relaxed);
+}
+
+inline void log(Level level, const std::string& message) {
+    if (!enabled(level)) return;
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.sink->write(level, message);
+}
+
+inline void flush() {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.sink->flush();
+}
+
+// One message, built with << and sent when the line goes out of scope. Nothing is formatted
+// if the level is disabled (the operands themselves are still evaluated).
+class Line {
+    Level level;
+    bool active;
+    std::ostringstream text;
+
+public:
+    explicit Line(Level level) : level(level), active(enabled(level)) {}
+    Line(const Line&) = delete;
+    Line& operator=(const Line&) = delete;
+    ~Line() { if (active) log(level, text.str()); }
+
+    template<typename T>
+    Line& operator<<(const T& value) {
+        if (active) text << value;
+        return *this;
+    }
+};
+
+inline Line debug() { return Line(Level::DEBUG); }
+inline Line info() { return Line(Level::INFO); }
+inline Line warning() { return Line(Level::WARNING); }
+inline Line error() { return Line(Level::ERROR); }
+
+}  // namespace logging
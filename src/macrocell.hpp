@@ -0,0 +1,103 @@
+#pragma once
+/*
+Macrocell (.mc) reading: Golly's quadtree file format, loaded straight into a HashLife universe.
+
+A file is a header line "[M2] ...", '#' comment lines (#R rule, #G generation), then one node
+per line, numbered from 1:
+- 8x8 leaves (level 3), as rows of '.' (dead) and '*' (alive) ended by '$'; trailing dead cells
+  and rows are omitted.
+- "level nw ne sw se" for higher levels, where children are earlier node numbers and 0 is empty.
+The last node is the root. As in Golly, the root is centered on the origin.
+
+No cell-by-cell expansion happens: nodes are hash-consed as they are read, and a KnownPattern
+built from the result only materializes the window queried through restrict_queries().
+*/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include "hashlife.hpp"
+#include "rle.hpp"  // for is_b3s23_rule
+
+// Read a macrocell file into `universe`. Returns the root positioned with its center at (0, 0).
+inline HashLifeState read_macrocell(const std::string& filename, HashLife& universe) {
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Could not open file for reading: " + filename);
+
+    std::vector<const QuadNode*> nodes = {nullptr};  // node numbers start at 1
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (line[0] == '[') {
+            if (line.compare(0, 4, "[M2]") != 0)
+                throw std::runtime_error("Macrocell: unsupported header in " + filename);
+            continue;
+        }
+        if (line[0] == '#') {
+            if (line.size() > 1 && line[1] == 'R' && !is_b3s23_rule(line.substr(2)))
+                throw std::runtime_error("Macrocell: unsupported rule '" + line.substr(2) + "' (only B3/S23)");
+            continue;
+        }
+        if (line[0] == '.' || line[0] == '*' || line[0] == '$') {
+            bool cells[8][8] = {};
+            int x = 0, y = 0;
+            for (char c : line) {
+                if (c == '$') {
+                    y++;
+                    x = 0;
+                } else if (c == '.' || c == '*') {
+                    if (x >= 8 || y >= 8)
+                        throw std::runtime_error("Macrocell: leaf larger than 8x8 on line " + std::to_string(line_number));
+                    cells[y][x++] = c == '*';
+                }
+            }
+            // join 2x2 blocks up to level 3
+            const QuadNode* level1[4][4];
+            for (int by = 0; by < 4; by++)
+                for (int bx = 0; bx < 4; bx++)
+                    level1[by][bx] = universe.join(universe.leaf(cells[2 * by][2 * bx]), universe.leaf(cells[2 * by][2 * bx + 1]),
+                                                   universe.leaf(cells[2 * by + 1][2 * bx]), universe.leaf(cells[2 * by + 1][2 * bx + 1]));
+            const QuadNode* level2[2][2];
+            for (int by = 0; by < 2; by++)
+                for (int bx = 0; bx < 2; bx++)
+                    level2[by][bx] = universe.join(level1[2 * by][2 * bx], level1[2 * by][2 * bx + 1],
+                                                   level1[2 * by + 1][2 * bx], level1[2 * by + 1][2 * bx + 1]);
+            nodes.push_back(universe.join(level2[0][0], level2[0][1], level2[1][0], level2[1][1]));
+            continue;
+        }
+        std::istringstream iss(line);
+        int level;
+        size_t child[4];
+        if (!(iss >> level >> child[0] >> child[1] >> child[2] >> child[3]) || level < 4)
+            throw std::runtime_error("Macrocell: malformed node on line " + std::to_string(line_number));
+        const QuadNode* c[4];
+        for (int i = 0; i < 4; i++) {
+            if (child[i] >= nodes.size())
+                throw std::runtime_error("Macrocell: forward reference on line " + std::to_string(line_number));
+            c[i] = child[i] == 0 ? universe.empty(level - 1) : nodes[child[i]];
+            if (c[i]->level != level - 1)
+                throw std::runtime_error("Macrocell: child level mismatch on line " + std::to_string(line_number));
+        }
+        nodes.push_back(universe.join(c[0], c[1], c[2], c[3]));
+    }
+    if (nodes.size() < 2)
+        throw std::runtime_error("Macrocell: no nodes in " + filename);
+
+    const QuadNode* root = nodes.back();
+    int64_t half = int64_t(1) << (root->level - 1);
+    return {root, -half, -half, 0};
+}
+
+// History of a macrocell pattern for KnownPattern's HASHLIFE backend, e.g.
+// KnownPattern pattern(load_macrocell("big.mc", 100));
+inline std::shared_ptr<HashLifeHistory> load_macrocell(const std::string& filename, int max_gen) {
+    return std::make_shared<HashLifeHistory>(
+        [&](HashLife& universe) { return read_macrocell(filename, universe); }, max_gen);
+}
@@ -0,0 +1,267 @@
+#pragma once
+/*
+Memory accounting: per-phase peak RSS, and optional allocation counting for the main containers.
+
+PhaseMemory measures the resident-set high-water mark of a phase. On Linux the kernel's VmHWM
+(/proc/self/status) is reset at the start of each phase by writing 5 to /proc/self/clear_refs, so
+the peak is the phase's own; where that is not possible the process-wide peak (VmHWM, or
+getrusage) is reported and marked as not exact. Nested phases fold the peak seen so far into
+the enclosing phases before resetting, so outer peaks stay correct. Since that reset also wipes
+the process-wide peak that anything else may read, PhaseMemory is a no-op until enable() is
+called, as with profiling::enable(); the benchmarks turn it on around their runs.
+
+With -DCOUNT_ALLOCATIONS, TrackedAllocator is a CountingAllocator that keeps live, peak and
+total bytes per AllocTag; without it, TrackedAllocator is std::allocator and costs nothing.
+*/
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <sys/resource.h>
+
+namespace memory_stats {
+
+// "12.3 MB"
+inline std::string format_bytes(size_t bytes) {
+    std::ostringstream oss;
+    if (bytes < 1024 * 1024) oss << bytes / 1024 << " KB";
+    else oss << std::fixed << std::setprecision(1) << bytes / (1024.0 * 1024.0) << " MB";
+    return oss.str();
+}
+
+// A "Vm...:" field of /proc/self/status in bytes, or 0 if unavailable.
+inline size_t proc_status_bytes(const char* field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    size_t len = std::strlen(field);
+    while (std::getline(status, line)) {
+        if (line.compare(0, len, field) == 0 && line.size() > len && line[len] == ':')
+            return std::stoull(line.substr(len + 1)) * 1024;  // reported in kB
+    }
+    return 0;
+}
+
+inline size_t current_rss_bytes() { return proc_status_bytes("VmRSS"); }
+
+// Peak RSS since the process started or the last reset_peak_rss().
+inline size_t peak_rss_bytes() {
+    size_t hwm = proc_status_bytes("VmHWM");
+    if (hwm) return hwm;
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return size_t(usage.ru_maxrss) * 1024;
+}
+
+// Peak RSS of the largest waited-for child process, e.g. the external SAT solver.
+inline size_t children_peak_rss_bytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_CHILDREN, &usage);
+    return size_t(usage.ru_maxrss) * 1024;
+}
+
+// Reset the kernel's high-water mark to the current RSS. Returns false if not supported.
+inline bool reset_peak_rss() {
+    FILE* f = std::fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool ok = std::fputs("5", f) >= 0;
+    ok = std::fclose(f) == 0 && ok;
+    return ok;
+}
+
+struct PhaseStats {
+    size_t start_rss = 0;  // RSS when the phase started
+    size_t peak_rss = 0;   // highest RSS during the phase
+    bool exact = true;     // false if peak_rss may include earlier phases
+};
+
+class PhaseMemory;
+
+namespace detail {
+
+struct State {
+    std::atomic<bool> enabled{false};
+    std::mutex mutex;
+    std::vector<PhaseMemory*> open;               // phases that have not stopped, outermost first
+    std::map<std::string, PhaseStats> results;    // last result of every phase name
+};
+
+inline State& state() {
+    static State instance;
+    return instance;
+}
+
+}  // namespace detail
+
+inline void enable(bool on = true) { detail::state().enabled.store(on, std::memory_order_relaxed); }
+inline bool enabled() { return detail::state().enabled.load(std::memory_order_relaxed); }
+
+// Peak RSS of the enclosing scope (or until stop()), recorded under `name` in phase_results().
+class PhaseMemory {
+    private:
+        std::string name;
+        PhaseStats stats;
+        bool tracking;
+        bool stopped = false;
+
+    public:
+        explicit PhaseMemory(std::string name) : name(std::move(name)), tracking(enabled()) {
+            if (!tracking) return;
+            detail::State& s = detail::state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            size_t peak = peak_rss_bytes();
+            for (PhaseMemory* outer : s.open) outer->stats.peak_rss = std::max(outer->stats.peak_rss, peak);
+            stats.exact = reset_peak_rss();
+            stats.start_rss = current_rss_bytes();
+            stats.peak_rss = stats.start_rss;
+            s.open.push_back(this);
+        }
+
+        PhaseMemory(const PhaseMemory&) = delete;
+        PhaseMemory& operator=(const PhaseMemory&) = delete;
+
+        ~PhaseMemory() { stop(); }
+
+        PhaseStats stop() {
+            if (stopped || !tracking) return stats;
+            stopped = true;
+            detail::State& s = detail::state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            stats.peak_rss = std::max(stats.peak_rss, peak_rss_bytes());
+            s.open.erase(std::remove(s.open.begin(), s.open.end(), this), s.open.end());
+            // an inner phase's peak is also reached in every enclosing phase
+            for (PhaseMemory* outer : s.open) outer->stats.peak_rss = std::max(outer->stats.peak_rss, stats.peak_rss);
+            s.results[name] = stats;
+            return stats;
+        }
+
+        // "peak RSS 12.3 MB (+4.0 MB)", or just the current "RSS 12.3 MB" when not tracking.
+        // Reads /proc either way, so only call it for output that is shown.
+        std::string describe() const {
+            if (!tracking) return "RSS " + format_bytes(current_rss_bytes());
+            PhaseStats st = stopped ? stats : PhaseStats{stats.start_rss, std::max(stats.peak_rss, peak_rss_bytes()), stats.exact};
+            std::string text = "peak RSS " + format_bytes(st.peak_rss);
+            if (st.exact) text += " (+" + format_bytes(st.peak_rss - std::min(st.peak_rss, st.start_rss)) + ")";
+            return text;
+        }
+};
+
+// Last recorded stats of every phase name.
+inline std::map<std::string, PhaseStats> phase_results() {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.results;
+}
+
+inline void clear_phase_results() {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.results.clear();
+}
+
+// === Allocation counting ===
+
+enum class AllocTag { CLAUSES, CELLS, UNION_FIND, DIMACS, COUNT };
+
+inline const char* tag_name(AllocTag tag) {
+    switch (tag) {
+        case AllocTag::CLAUSES: return "clauses";
+        case AllocTag::CELLS: return "cells";
+        case AllocTag::UNION_FIND: return "union-find";
+        case AllocTag::DIMACS: return "DIMACS";
+        default: return "?";
+    }
+}
+
+struct AllocCounters {
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> live_bytes{0};
+    std::atomic<int64_t> peak_bytes{0};
+    std::atomic<int64_t> total_bytes{0};
+};
+
+inline AllocCounters& alloc_counters(AllocTag tag) {
+    static AllocCounters counters[int(AllocTag::COUNT)];
+    return counters[int(tag)];
+}
+
+inline void note_allocation(AllocTag tag, size_t bytes) {
+    AllocCounters& c = alloc_counters(tag);
+    c.allocations++;
+    c.total_bytes += bytes;
+    int64_t live = c.live_bytes += bytes;
+    int64_t peak = c.peak_bytes.load();
+    while (live > peak && !c.peak_bytes.compare_exchange_weak(peak, live)) {}
+}
+
+inline void note_deallocation(AllocTag tag, size_t bytes) {
+    alloc_counters(tag).live_bytes -= bytes;
+}
+
+inline void reset_allocation_counts() {
+    for (int i = 0; i < int(AllocTag::COUNT); i++) {
+        AllocCounters& c = alloc_counters(AllocTag(i));
+        c.allocations = 0;
+        c.total_bytes = 0;
+        c.peak_bytes = c.live_bytes.load();
+    }
+}
+
+// One line per tag with any allocations: count, total, peak live and live bytes.
+inline std::string allocation_report() {
+    std::ostringstream out;
+    for (int i = 0; i < int(AllocTag::COUNT); i++) {
+        AllocCounters& c = alloc_counters(AllocTag(i));
+        if (c.allocations == 0) continue;
+        out << "  " << std::left << std::setw(12) << tag_name(AllocTag(i)) << std::right
+            << c.allocations << " allocations, " << format_bytes(c.total_bytes) << " total, "
+            << format_bytes(c.peak_bytes) << " peak, " << format_bytes(std::max<int64_t>(c.live_bytes, 0)) << " live\n";
+    }
+    return out.str();
+}
+
+template<typename T, AllocTag Tag>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U, Tag>&) {}
+
+    template<typename U>
+    struct rebind { using other = CountingAllocator<U, Tag>; };
+
+    T* allocate(size_t n) {
+        note_allocation(Tag, n * sizeof(T));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) {
+        note_deallocation(Tag, n * sizeof(T));
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U, Tag>&) const { return true; }
+    template<typename U>
+    bool operator!=(const CountingAllocator<U, Tag>&) const { return false; }
+};
+
+#ifdef COUNT_ALLOCATIONS
+template<typename T, AllocTag Tag>
+using TrackedAllocator = CountingAllocator<T, Tag>;
+#else
+template<typename T, AllocTag Tag>
+using TrackedAllocator = std::allocator<T>;
+#endif
+
+}  // namespace memory_stats
@@ -0,0 +1,88 @@
+#pragma once
+/*
+Population minimization on an incremental solver: find a solution, then keep asking for one with
+fewer live cells in a region until there is none. The population is counted by a totalizer
+encoded once, after the first solution (capped at that solution's count), and each tighter bound
+"at most k" is just the assumption -out[k] on one of its output bits, so nothing is re-encoded and
+everything learned carries over from one bound to the next.
+
+    CdclSolver solver;
+    solver.add_clauses(problem.get_clauses());
+    solver.add_clause(generation_alive_clause(problem, 0));
+    MinimizationResult best = minimize_population(solver, generation_sum(problem, 0), problem.num_variables());
+
+Each SAT answer may drop the count by more than one; the first UNSAT proves the last solution
+minimal. Bounds are only ever assumed, so the solver is left as it was (plus the totalizer).
+*/
+
+#include <vector>
+#include "cardinality.hpp"
+#include "incremental_solver.hpp"
+#include "profiling.hpp"
+#include "logging.hpp"
+
+struct MinimizationResult {
+    SolverStatus status = SolverStatus::UNSAT;  // SAT with the minimum, UNSAT if there is no solution
+    int population = -1;                        // the minimum, known live cells included
+    SolverResult solution;                      // a witness, over the model variables
+    int solves = 0;
+};
+
+// Minimize the population of `sum` over the solver's clauses (and `assumptions`). The witness
+// covers variables 1..num_variables.
+inline MinimizationResult minimize_population(IncrementalSolver& solver, const CellSum& sum, int num_variables,
+                                              const std::vector<int>& assumptions = {}) {
+    profiling::ScopedTimer timer("minimize_population");
+    solver.reserve_variables(num_variables);
+    auto count = [&]() {
+        int live = 0;
+        for (int lit : sum.literals) live += solver.value(lit);
+        return live;
+    };
+
+    MinimizationResult result;
+    std::vector<int> outputs;
+    std::vector<int> bounded = assumptions;
+    int bound = -1;  // the last count found, once there is one: later solves assume fewer
+    while (true) {
+        profiling::ScopedTimer step_timer("population bound");
+        if (bound >= 0) bounded.back() = -outputs[bound - 1];
+        SolverStatus status = solver.solve(bounded);
+        result.solves++;
+        step_timer.stop();
+        if (status == SolverStatus::ERROR) {
+            result.status = status;
+            break;
+        }
+        if (status == SolverStatus::UNSAT) {
+            if (bound >= 0)
+                logging::info() << "  Population <= " << sum.alive + bound - 1 << ": UNSAT in "
+                                << format_duration(step_timer.elapsed_ms());
+            break;
+        }
+
+        int live = count();
+        result.status = SolverStatus::SAT;
+        result.population = sum.alive + live;
+        result.solution = solver.model(num_variables);
+        logging::info() << "  Population " << result.population << " found in "
+                        << format_duration(step_timer.elapsed_ms());
+        if (live == 0) break;
+
+        if (outputs.empty()) {
+            // outputs[k] is "at least k + 1 live", needed up to the count just found
+            CardinalityEncoder encoder(solver.num_variables());
+            BigClauseList clauses;
+            outputs = encoder.totalizer(clauses, sum.literals, live, true, false);
+            solver.reserve_variables(encoder.num_variables());
+            solver.add_clauses(clauses);
+            bounded.push_back(0);
+        }
+        bound = live;
+    }
+
+    timer.stop();
+    logging::info() << "  Minimization: population " << result.population << " after " << result.solves
+                    << " solves in " << format_duration(timer.elapsed_ms());
+    return result;
+}
@@ -0,0 +1,146 @@
+#pragma once
+/*
+Hardware performance counters (cycles, instructions, cache misses, branch misses) read through
+Linux perf_event_open, for telling apart why a phase is slow rather than only how slow.
+
+    perf_counters::enable();
+    perf_counters::Sample before = perf_counters::read();
+    ...
+    perf_counters::Sample used = perf_counters::read() - before;
+    if (used.has(perf_counters::INSTRUCTIONS)) ...
+
+Counters are per thread (user space only) and opened on a thread's first read(). Where
+perf_event_open is unavailable (not Linux, perf_event_paranoid, containers) or a counter is not
+supported by the CPU, the affected counters are simply missing from every Sample. Multiplexed
+counters are scaled by their enabled / running time.
+
+profiling::ScopedTimer attaches the counters used by each recorded timer when both profiling
+and perf_counters are enabled.
+*/
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+namespace perf_counters {
+
+enum Counter { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, NUM_COUNTERS };
+
+inline const char* counter_name(int counter) {
+    static const char* names[NUM_COUNTERS] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+    return names[counter];
+}
+
+struct Sample {
+    std::array<uint64_t, NUM_COUNTERS> values{};
+    unsigned valid = 0;  // bit c is set if counter c was read
+
+    bool has(int counter) const { return valid & (1u << counter); }
+    bool empty() const { return valid == 0; }
+
+    double ipc() const {
+        return has(CYCLES) && has(INSTRUCTIONS) && values[CYCLES] ? double(values[INSTRUCTIONS]) / values[CYCLES] : 0;
+    }
+
+    // Differences and sums keep the counters valid in both operands; an empty operand counts as zero
+    Sample operator-(const Sample& other) const {
+        if (other.empty()) return *this;
+        Sample result;
+        result.valid = valid & other.valid;
+        for (int c = 0; c < NUM_COUNTERS; c++)
+            if (result.has(c)) result.values[c] = values[c] > other.values[c] ? values[c] - other.values[c] : 0;
+        return result;
+    }
+
+    Sample operator+(const Sample& other) const {
+        if (empty()) return other;
+        if (other.empty()) return *this;
+        Sample result;
+        result.valid = valid & other.valid;
+        for (int c = 0; c < NUM_COUNTERS; c++)
+            if (result.has(c)) result.values[c] = values[c] + other.values[c];
+        return result;
+    }
+};
+
+namespace detail {
+
+inline std::atomic<bool>& enabled_flag() {
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+#ifdef __linux__
+struct ThreadCounters {
+    std::array<int, NUM_COUNTERS> fds;
+
+    ThreadCounters() {
+        static const uint64_t configs[NUM_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[c];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[c] = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));  // this thread, any CPU
+        }
+    }
+
+    ~ThreadCounters() {
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+};
+
+inline ThreadCounters& thread_counters() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+#endif
+
+}  // namespace detail
+
+// Counters are only read while enabled; read() returns an empty Sample otherwise.
+inline void enable(bool on = true) { detail::enabled_flag().store(on, std::memory_order_relaxed); }
+inline bool enabled() { return detail::enabled_flag().load(std::memory_order_relaxed); }
+
+// Current counter values of the calling thread
+inline Sample read() {
+    Sample sample;
+#ifdef __linux__
+    if (!enabled()) return sample;
+    detail::ThreadCounters& counters = detail::thread_counters();
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        if (counters.fds[c] < 0) continue;
+        uint64_t data[3];  // value, time enabled, time running
+        if (::read(counters.fds[c], data, sizeof(data)) != ssize_t(sizeof(data))) continue;
+        uint64_t value = data[0];
+        if (data[2] > 0 && data[2] < data[1]) value = uint64_t(double(value) * data[1] / data[2]);
+        sample.values[c] = value;
+        sample.valid |= 1u << c;
+    }
+#endif
+    return sample;
+}
+
+// Whether any counter can be read on this thread (while enabled)
+inline bool available() {
+    return !read().empty();
+}
+
+}  // namespace perf_counters
@@ -0,0 +1,138 @@
+#pragma once
+/*
+Period, displacement and glide symmetry detection.
+
+Each generation is normalized (trimmed to its live bounding box and moved to the origin) and
+hashed once. Generation t is a repeat of generation 0 if its hash matches, and the planes agree,
+for one of generation 0's normalized images. The first t matching the identity image is the
+(minimal) period. When orientations are allowed, the other 7 D4_TRANSFORMS images are checked in
+the same pass, and the first earlier t matching one of them is a glide symmetry: e.g. the LWSS has
+period 4 and reappears reflected after 2 generations.
+
+Both come as AffineTransfs T with state(p) == state(T(p)) for every (x, y, t), in the same form
+VariablePattern cell groups use: {1, 0, 0, 1, -2, 0, 4} and, for the glide, {1, 0, 0, -1, -1, 4, 2}
+for the LWSS.
+
+To check a solver solution, pass its generation 0, e.g. detect_period(extract_generation(problem,
+result, 0), ...): a smaller period than searched for means a lower-period object.
+*/
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "geometry.hpp"
+#include "bitboard.hpp"
+#include "known_pattern.hpp"
+
+struct PeriodInfo {
+    bool found = false;
+    int period = 0;        // generations until the pattern repeats as it was
+    int dx = 0, dy = 0;    // displacement over one period
+
+    // Glide symmetry (only looked for when orientations are allowed): the pattern first reappears
+    // transformed after glide_period < period generations, oriented by
+    // D4_TRANSFORMS[glide_orientation] then moved by (glide_dx, glide_dy). 0 if there is none.
+    int glide_period = 0;
+    int glide_orientation = 0;
+    int glide_dx = 0, glide_dy = 0;
+
+    bool moves() const { return dx != 0 || dy != 0; }
+    bool glides() const { return glide_period > 0; }
+
+    // (x, y, t) -> (x + dx, y + dy, t + period)
+    AffineTransf transf() const { return {1, 0, 0, 1, dx, dy, period}; }
+
+    // (x, y, t) -> (A (x, y) + (glide_dx, glide_dy), t + glide_period), A = D4_TRANSFORMS[glide_orientation]
+    AffineTransf glide_transf() const {
+        const int* a = D4_TRANSFORMS[glide_orientation];
+        return {a[0], a[1], a[2], a[3], glide_dx, glide_dy, glide_period};
+    }
+};
+
+namespace period_detail {
+
+// 64-bit FNV-1a over the plane size and words
+inline uint64_t plane_hash(const BitPlane& plane) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto mix = [&](uint64_t v) {
+        h ^= v;
+        h *= 0x100000001b3ULL;
+    };
+    mix(uint64_t(uint32_t(plane.width)) << 32 | uint32_t(plane.height));
+    for (uint64_t w : plane.words) mix(w);
+    return h;
+}
+
+// `generation(t)` returns any plane holding all live cells of generation t, for t = 1, 2, ... in order.
+inline PeriodInfo detect(const BitPlane& gen0, int max_period, bool orientations,
+                         const std::function<BitPlane(int)>& generation, std::vector<BitPlane>* phases) {
+    PeriodInfo info;
+    BitPlane start = gen0.trimmed();
+    if (phases) phases->assign(1, start);
+    if (start.width == 0) return info;
+
+    // Normalized images of generation 0, with the position each orientation moves its bounding box to
+    struct Image {
+        BitPlane normalized;
+        uint64_t hash;
+        int x0, y0;
+    };
+    std::vector<Image> images;
+    for (int o = 0; o < (orientations ? 8 : 1); o++) {
+        BitPlane image = o == 0 ? start : transformed(start, o).trimmed();
+        BitPlane normalized = translated_to(image, 0, 0);
+        uint64_t hash = plane_hash(normalized);
+        images.push_back({std::move(normalized), hash, image.x0, image.y0});
+    }
+
+    for (int t = 1; t <= max_period; t++) {
+        BitPlane live = generation(t).trimmed();
+        if (live.width == 0) {
+            // died out, so it can never repeat
+            if (phases) phases->push_back(std::move(live));
+            break;
+        }
+        BitPlane normalized = translated_to(live, 0, 0);
+        uint64_t hash = plane_hash(normalized);
+        if (images[0].hash == hash && images[0].normalized == normalized) {
+            info.found = true;
+            info.period = t;
+            info.dx = live.x0 - images[0].x0;
+            info.dy = live.y0 - images[0].y0;
+            return info;
+        }
+        for (int o = 1; o < int(images.size()) && !info.glides(); o++) {
+            if (images[o].hash != hash || images[o].normalized != normalized) continue;
+            info.glide_period = t;
+            info.glide_orientation = o;
+            info.glide_dx = live.x0 - images[o].x0;
+            info.glide_dy = live.y0 - images[o].y0;
+        }
+        if (phases) phases->push_back(std::move(live));
+    }
+    return info;
+}
+
+}  // namespace period_detail
+
+// Period of a pattern given by generation 0, evolving it for up to max_period generations.
+// If `phases` is given it receives the trimmed generations 0 .. period - 1 (all evolved
+// generations if no period is found; the last one is empty if the pattern died out).
+inline PeriodInfo detect_period(const BitPlane& gen0, int max_period, bool orientations = false,
+                                std::vector<BitPlane>* phases = nullptr) {
+    BitPlane work = gen0.trimmed().padded(1);
+    auto generation = [&](int) {
+        if (!work.border_clear()) work = work.trimmed().padded(32);
+        work = life_step(work);
+        return work;
+    };
+    return period_detail::detect(gen0, max_period, orientations, generation, phases);
+}
+
+// Period of a known pattern within its own generations (shift applied).
+inline PeriodInfo detect_period(const KnownPattern& pattern, bool orientations = false) {
+    auto [xlims, ylims, tlims] = pattern.get_bounds();
+    auto generation = [&](int t) { return pattern.get_generation(tlims.first + t); };
+    return period_detail::detect(pattern.get_generation(tlims.first), tlims.second - tlims.first,
+                                 orientations, generation, nullptr);
+}
@@ -1,9 +1,41 @@
 #pragma once
+/*
+Profiling: scoped phase timers and named counters, exported as Chrome trace-event JSON
+(chrome://tracing, Perfetto) or a text summary.
+
+    profiling::enable();
+    {
+        profiling::ScopedTimer timer("build");     // nested timers form a tree per thread
+        profiling::count("clauses", n);
+    }
+    profiling::write_chrome_trace_file("trace.json");
+    std::cout << profiling::summary();
+
+Each thread records into its own buffer, so timers need no locking; buffers outlive their
+threads until reset(). When profiling is disabled (the default) a timer only reads the clock,
+for elapsed_ms(), and counters return immediately; compiling with -DPROFILING_DISABLED removes
+recording and counters altogether but keeps that clock read, so console timings stay correct.
+
+With perf_counters::enable() as well, each recorded timer also carries the hardware counters its
+thread used between start and stop (see perf_counters.hpp); they appear in the trace arguments,
+the summary, and timer_counters().
+*/
+
 #include <chrono>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+#include "file_utils.hpp"
+#include "perf_counters.hpp"
 
 // Format a duration in milliseconds as a human-readable string
 inline std::string format_duration(long long ms) {
@@ -28,3 +60,288 @@ inline std::string format_duration(long long ms) {
     }
     return oss.str();
 }
+
+namespace profiling {
+
+namespace detail {
+
+struct Event {
+    std::string path;     // names of the enclosing timers and this one, joined by '/'
+    int64_t start_ns;     // since the process epoch
+    int64_t duration_ns;  // < 0 for counter samples
+    int64_t value;        // counter value after this sample
+    perf_counters::Sample hardware;  // hardware counters used by a timer (empty if not read)
+};
+
+struct ThreadBuffer {
+    int tid;
+    std::vector<Event> events;
+    std::vector<const char*> stack;      // names of the open timers
+    std::map<std::string, int64_t> counters;
+};
+
+struct State {
+    std::atomic<bool> enabled{false};
+    std::mutex mutex;  // guards `buffers` (registration and export only)
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::atomic<uint64_t> generation{0};  // bumped by reset() so threads re-register
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+inline State& state() {
+    static State instance;
+    return instance;
+}
+
+inline int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - state().epoch).count();
+}
+
+// This thread's buffer, registered on first use (and again after reset()).
+inline ThreadBuffer& buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> local;
+    thread_local uint64_t local_generation = 0;
+    State& s = state();
+    uint64_t gen = s.generation.load(std::memory_order_acquire);
+    if (!local || local_generation != gen) {
+        auto fresh = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        fresh->tid = int(s.buffers.size()) + 1;
+        s.buffers.push_back(fresh);
+        if (local) fresh->stack = local->stack;  // timers still open across a reset
+        local = fresh;
+        local_generation = gen;
+    }
+    return *local;
+}
+
+inline std::string path_of(const std::vector<const char*>& stack) {
+    std::string path;
+    for (const char* name : stack) {
+        if (!path.empty()) path += '/';
+        path += name;
+    }
+    return path;
+}
+
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c < 0x20) continue;
+        out += c;
+    }
+    return out;
+}
+
+}  // namespace detail
+
+inline void enable(bool on = true) { detail::state().enabled.store(on, std::memory_order_relaxed); }
+inline bool enabled() { return detail::state().enabled.load(std::memory_order_relaxed); }
+
+// Drop everything recorded so far.
+inline void reset() {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.buffers.clear();
+    s.generation++;
+}
+
+// Times the enclosing scope (or until stop()). `name` must outlive the timer, e.g. a literal.
+class ScopedTimer {
+    private:
+        const char* name;
+        int64_t start = 0;
+        bool recording = false;
+        bool stopped = false;
+        int64_t elapsed = 0;
+        perf_counters::Sample hardware_start;
+
+    public:
+        explicit ScopedTimer(const char* name) : name(name) {
+            start = detail::now_ns();
+#ifndef PROFILING_DISABLED
+            recording = enabled();
+            if (recording) {
+                detail::buffer().stack.push_back(name);
+                hardware_start = perf_counters::read();
+            }
+#endif
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        ~ScopedTimer() { stop(); }
+
+        // End the timed section early. Returns the elapsed time in nanoseconds.
+        int64_t stop() {
+            if (stopped) return elapsed;
+            stopped = true;
+            elapsed = detail::now_ns() - start;
+#ifndef PROFILING_DISABLED
+            if (recording) {
+                perf_counters::Sample hardware;
+                if (!hardware_start.empty()) hardware = perf_counters::read() - hardware_start;
+                detail::ThreadBuffer& buf = detail::buffer();
+                buf.events.push_back({detail::path_of(buf.stack), start, elapsed, 0, hardware});
+                if (!buf.stack.empty()) buf.stack.pop_back();
+            }
+#endif
+            return elapsed;
+        }
+
+        // Time since the timer started (or its total once stopped), in milliseconds.
+        long long elapsed_ms() const {
+            int64_t ns = stopped ? elapsed : detail::now_ns() - start;
+            return ns / 1000000;
+        }
+};
+
+// Add `delta` to a named counter of this thread.
+inline void count(const char* name, int64_t delta = 1) {
+#ifndef PROFILING_DISABLED
+    if (!enabled()) return;
+    detail::ThreadBuffer& buf = detail::buffer();
+    int64_t& value = buf.counters[name];
+    value += delta;
+    buf.events.push_back({name, detail::now_ns(), -1, value, {}});
+#else
+    (void)name;
+    (void)delta;
+#endif
+}
+
+// Total of a named counter over all threads.
+inline int64_t counter_total(const std::string& name) {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    int64_t total = 0;
+    for (const auto& buf : s.buffers) {
+        auto it = buf->counters.find(name);
+        if (it != buf->counters.end()) total += it->second;
+    }
+    return total;
+}
+
+// Total time of all timers recorded at a nesting path (e.g. "SearchProblem::build/dedup transitions").
+inline int64_t timer_total_ns(const std::string& path) {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    int64_t total = 0;
+    for (const auto& buf : s.buffers)
+        for (const detail::Event& e : buf->events)
+            if (e.duration_ns >= 0 && e.path == path) total += e.duration_ns;
+    return total;
+}
+
+// Hardware counters summed over all timers recorded at a nesting path (empty if none were read).
+inline perf_counters::Sample timer_counters(const std::string& path) {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    perf_counters::Sample total;
+    for (const auto& buf : s.buffers)
+        for (const detail::Event& e : buf->events)
+            if (e.duration_ns >= 0 && e.path == path) total = total + e.hardware;
+    return total;
+}
+
+// All recorded timers and counter samples in Chrome trace-event format.
+// Call once the threads being profiled are done recording.
+inline void write_chrome_trace(std::ostream& out) {
+    detail::State& s = detail::state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buf : s.buffers) {
+        for (const detail::Event& e : buf->events) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            std::string name = e.path.substr(e.path.rfind('/') + 1);
+            out << std::fixed << std::setprecision(3);
+            if (e.duration_ns >= 0) {
+                out << "{\"name\":\"" << detail::json_escape(name) << "\",\"cat\":\"phase\",\"ph\":\"X\""
+                    << ",\"ts\":" << e.start_ns / 1000.0 << ",\"dur\":" << e.duration_ns / 1000.0
+                    << ",\"pid\":1,\"tid\":" << buf->tid
+                    << ",\"args\":{\"path\":\"" << detail::json_escape(e.path) << "\"";
+                for (int c = 0; c < perf_counters::NUM_COUNTERS; c++)
+                    if (e.hardware.has(c)) out << ",\"" << perf_counters::counter_name(c) << "\":" << e.hardware.values[c];
+                out << "}}";
+            } else {
+                out << "{\"name\":\"" << detail::json_escape(name) << "\",\"ph\":\"C\""
+                    << ",\"ts\":" << e.start_ns / 1000.0 << ",\"pid\":1,\"tid\":" << buf->tid
+                    << ",\"args\":{\"value\":" << e.value << "}}";
+            }
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+inline void write_chrome_trace_file(const std::string& filename, bool overwrite = true) {
+    std::ofstream file = file_checks(filename, overwrite);
+    write_chrome_trace(file);
+}
+
+// Per-timer totals, aggregated over threads by nesting path and indented by depth, then counter totals.
+// Timers with hardware counters also show IPC and thousands of cache and branch misses.
+inline std::string summary() {
+    struct Stats {
+        int64_t count = 0, total = 0, min = INT64_MAX, max = 0;
+        perf_counters::Sample hardware;
+    };
+    bool any_hardware = false;
+    std::map<std::string, Stats> timers;
+    std::map<std::string, int64_t> counters;
+    {
+        detail::State& s = detail::state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        for (const auto& buf : s.buffers) {
+            for (const detail::Event& e : buf->events) {
+                if (e.duration_ns < 0) continue;
+                // '\1' sorts before any name character, so children follow their parent
+                std::string key = e.path;
+                std::replace(key.begin(), key.end(), '/', '\1');
+                Stats& st = timers[key];
+                st.count++;
+                st.total += e.duration_ns;
+                st.min = std::min(st.min, e.duration_ns);
+                st.max = std::max(st.max, e.duration_ns);
+                st.hardware = st.hardware + e.hardware;
+                any_hardware |= !e.hardware.empty();
+            }
+            for (const auto& [name, value] : buf->counters) counters[name] += value;
+        }
+    }
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << std::left << std::setw(40) << "timer" << std::right << std::setw(8) << "count"
+        << std::setw(14) << "total ms" << std::setw(12) << "mean ms" << std::setw(12) << "max ms";
+    if (any_hardware) out << std::setw(8) << "IPC" << std::setw(14) << "cache miss k" << std::setw(14) << "branch miss k";
+    out << "\n";
+    for (const auto& [key, st] : timers) {
+        int depth = std::count(key.begin(), key.end(), '\1');
+        std::string label = std::string(2 * depth, ' ') + key.substr(key.rfind('\1') + 1);
+        out << std::left << std::setw(40) << label << std::right << std::setw(8) << st.count
+            << std::setw(14) << st.total / 1e6 << std::setw(12) << st.total / 1e6 / st.count
+            << std::setw(12) << st.max / 1e6;
+        if (any_hardware) {
+            using namespace perf_counters;
+            const Sample& hw = st.hardware;
+            out << std::setprecision(2) << std::setw(8) << hw.ipc() << std::setprecision(1)
+                << std::setw(14) << (hw.has(CACHE_MISSES) ? hw.values[CACHE_MISSES] / 1e3 : 0.0)
+                << std::setw(14) << (hw.has(BRANCH_MISSES) ? hw.values[BRANCH_MISSES] / 1e3 : 0.0)
+                << std::setprecision(3);
+        }
+        out << "\n";
+    }
+    if (!counters.empty()) {
+        out << std::left << std::setw(40) << "counter" << std::right << std::setw(8) << "" << std::setw(14) << "total" << "\n";
+        for (const auto& [name, value] : counters)
+            out << std::left << std::setw(40) << name << std::right << std::setw(8) << "" << std::setw(14) << value << "\n";
+    }
+    return out.str();
+}
+
+}  // namespace profiling
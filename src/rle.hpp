@@ -0,0 +1,248 @@
+#pragma once
+/*
+RLE reading and writing for BitPlanes.
+
+parse_rle() decodes RLE text straight into a plane in a single pass. When the header gives the
+pattern size the plane is allocated once up front; otherwise it grows geometrically.
+read_rle_file() memory-maps the file and parses it in place, without copying it into a string.
+
+plane_to_rle() / write_rle() encode a plane, walking runs a word at a time.
+Only B3/S23 is supported, matching the evolution engines; other rules are rejected.
+*/
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "bitboard.hpp"
+#include "file_utils.hpp"
+
+struct RleHeader {
+    int width = -1;   // -1 if the header is missing
+    int height = -1;
+    std::string rule; // empty if not given
+};
+
+// True if the rule string names Conway's Life (B3/S23, S23/B3 or 23/3, any case).
+inline bool is_b3s23_rule(std::string rule) {
+    std::string r;
+    for (char c : rule)
+        if (!std::isspace((unsigned char)c)) r += std::toupper((unsigned char)c);
+    return r.empty() || r == "B3/S23" || r == "S23/B3" || r == "23/3";
+}
+
+namespace rle_detail {
+
+// Parse "x = 3, y = 1, rule = B3/S23" (the leading 'x' included).
+inline RleHeader parse_header(const char* begin, const char* end) {
+    RleHeader header;
+    std::string line(begin, end);
+    std::istringstream iss(line);
+    std::string field;
+    while (std::getline(iss, field, ',')) {
+        size_t eq = field.find('=');
+        if (eq == std::string::npos) continue;
+        std::string key, value;
+        for (size_t i = 0; i < eq; i++)
+            if (!std::isspace((unsigned char)field[i])) key += field[i];
+        size_t v = eq + 1;
+        while (v < field.size() && std::isspace((unsigned char)field[v])) v++;
+        value = field.substr(v);
+        while (!value.empty() && std::isspace((unsigned char)value.back())) value.pop_back();
+        if (key == "x") header.width = std::stoi(value);
+        else if (key == "y") header.height = std::stoi(value);
+        else if (key == "rule") header.rule = value;
+    }
+    return header;
+}
+
+// Set cells [x, x + n) of local row ly.
+inline void fill_run(BitPlane& plane, int ly, int x, int n) {
+    uint64_t* row = plane.row(ly);
+    int end = x + n;
+    while (x < end) {
+        int k = x >> 6, bit = x & 63;
+        int take = std::min(64 - bit, end - x);
+        uint64_t mask = take == 64 ? ~uint64_t(0) : ((uint64_t(1) << take) - 1) << bit;
+        row[k] |= mask;
+        x += take;
+    }
+}
+
+}  // namespace rle_detail
+
+// Decode RLE text in [begin, end). Generation 0 has its upper-left cell at (0, 0). The plane covers
+// the header's size if given (grown if the cells exceed it), else exactly the rows and columns used.
+inline BitPlane parse_rle(const char* begin, const char* end, RleHeader* header_out = nullptr) {
+    using namespace rle_detail;
+    RleHeader header;
+    BitPlane plane;
+    int x = 0, y = 0, max_x = -1;
+    int count = 0;
+
+    auto ensure = [&](int x_end, int row) {
+        if (x_end <= plane.width && row < plane.height) return;
+        int w = plane.width, h = plane.height;
+        while (w < x_end) w = std::max(2 * w, 64);
+        while (h <= row) h = std::max(2 * h, 16);
+        plane = plane.cropped(0, 0, w, h);
+    };
+
+    const char* p = begin;
+    while (p < end) {
+        char c = *p;
+        if (c == '#' || c == 'x') {
+            const char* eol = p;
+            while (eol < end && *eol != '\n') eol++;
+            if (c == 'x') {
+                header = parse_header(p, eol);
+                if (!is_b3s23_rule(header.rule))
+                    throw std::runtime_error("RLE: unsupported rule '" + header.rule + "' (only B3/S23)");
+                if (header.width > 0 && header.height > 0 && plane.width == 0)
+                    plane = BitPlane(0, 0, header.width, header.height);
+            }
+            p = eol;
+            continue;
+        }
+        if (c >= '0' && c <= '9') {
+            count = count * 10 + (c - '0');
+        } else if (c == 'b' || c == '.' || c == 'o' || c == 'A' || c == '$' || c == '!') {
+            int n = count == 0 ? 1 : count;
+            count = 0;
+            if (c == 'b' || c == '.') {
+                x += n;
+            } else if (c == 'o' || c == 'A') {
+                ensure(x + n, y);
+                fill_run(plane, y, x, n);
+                x += n;
+                max_x = std::max(max_x, x - 1);
+            } else if (c == '$') {
+                y += n;
+                x = 0;
+            } else {
+                break;
+            }
+        } else if (!std::isspace((unsigned char)c)) {
+            throw std::runtime_error(std::string("RLE: unexpected character '") + c + "'");
+        }
+        p++;
+    }
+
+    // Without a header, cover exactly the columns and rows used (the final row is included even if
+    // empty, so trailing '$'s are kept).
+    int width = std::max(header.width, max_x + 1);
+    int height = std::max(header.height, y + 1);
+    if (plane.width != width || plane.height != height)
+        plane = plane.cropped(0, 0, width, height);
+    if (header_out) *header_out = header;
+    return plane;
+}
+
+inline BitPlane parse_rle(const std::string& rle, RleHeader* header_out = nullptr) {
+    return parse_rle(rle.data(), rle.data() + rle.size(), header_out);
+}
+
+// Memory-map an RLE file and parse it without reading it into a string.
+inline BitPlane read_rle_file(const std::string& filename, RleHeader* header_out = nullptr) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Could not open file for reading: " + filename);
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        throw std::runtime_error("Could not stat file: " + filename);
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return parse_rle(nullptr, nullptr, header_out);
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw std::runtime_error("Could not mmap file: " + filename);
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    const char* text = static_cast<const char*>(data);
+    try {
+        BitPlane plane = parse_rle(text, text + st.st_size, header_out);
+        munmap(data, st.st_size);
+        return plane;
+    } catch (...) {
+        munmap(data, st.st_size);
+        throw;
+    }
+}
+
+// Encode the live cells of a plane as RLE (header included), cropped to their bounding box.
+// Lines are wrapped at 70 characters.
+inline void write_rle(std::ostream& out, const BitPlane& plane, const std::string& rule = "B3/S23") {
+    int xmin = 0, xmax = -1, ymin = 0, ymax = -1;
+    plane.live_bounds(xmin, xmax, ymin, ymax);
+    std::string body;
+    body.reserve(size_t(plane.population()) * 2 + (ymax - ymin + 2) * 2);
+    int line_len = 0;
+    auto emit = [&](int n, char c) {
+        char buf[16];
+        int len = 0;
+        if (n > 1) len = snprintf(buf, sizeof(buf), "%d", n);
+        buf[len++] = c;
+        if (line_len + len > 70) {
+            body += '\n';
+            line_len = 0;
+        }
+        body.append(buf, len);
+        line_len += len;
+    };
+
+    int pending_rows = 0;  // '$'s not yet written (empty rows are merged into one run)
+    for (int y = ymin; y <= ymax; y++) {
+        const uint64_t* row = plane.row(y - plane.y0);
+        int lx = xmin - plane.x0, lend = xmax - plane.x0 + 1;
+        bool any = false;
+        while (lx < lend) {
+            // find next live cell at or after lx
+            int k = lx >> 6;
+            uint64_t w = row[k] & (~uint64_t(0) << (lx & 63));
+            while (!w && ++k < plane.stride) w = row[k];
+            if (!w) break;
+            int start = 64 * k + __builtin_ctzll(w);
+            if (start >= lend) break;
+            // find the end of the run
+            uint64_t inv = ~row[k] & (~uint64_t(0) << (start & 63));
+            while (!inv && ++k < plane.stride) inv = ~row[k];
+            int stop = k < plane.stride ? std::min(64 * k + __builtin_ctzll(inv), lend) : lend;
+            if (!any && pending_rows) {
+                emit(pending_rows, '$');
+                pending_rows = 0;
+            }
+            any = true;
+            if (start > lx) emit(start - lx, 'b');
+            emit(stop - start, 'o');
+            lx = stop;
+        }
+        pending_rows++;
+    }
+    emit(1, '!');
+
+    out << "x = " << (xmax - xmin + 1) << ", y = " << (ymax - ymin + 1) << ", rule = " << rule << "\n"
+        << body << "\n";
+}
+
+inline std::string plane_to_rle(const BitPlane& plane, const std::string& rule = "B3/S23") {
+    std::ostringstream oss;
+    write_rle(oss, plane, rule);
+    return oss.str();
+}
+
+inline void write_rle_file(const BitPlane& plane, const std::string& filename, bool overwrite = false) {
+    std::ofstream file = file_checks(filename, overwrite);
+    write_rle(file, plane);
+}
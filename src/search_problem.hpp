@@ -17,14 +17,17 @@ The SearchProblem:
 #include <cassert>
 #include <stdexcept>
 #include <algorithm>
+#include <climits>
 #include <map>
 #include <unordered_map>
-#include <chrono>
-#include <iostream>
 #include "sub_pattern.hpp"
 #include "sat_logic.hpp"
 #include "union_find.hpp"
 #include "profiling.hpp"
+#include "memory_stats.hpp"
+#include "logging.hpp"
+#include "encoding_stats.hpp"
+#include "heatmap.hpp"
 
 // Hash function for transition signatures (center + 8 sorted neighbors)
 struct SignatureHash {
@@ -37,6 +40,36 @@ struct SignatureHash {
     }
 };
 
+// Append the GoL clauses of one transition to `clauses`. `ten_cells` holds the 3x3 neighborhood
+// (row-major) then the output cell, each 0 = dead, 1 = alive or >= 2 = SAT variable + 1.
+// Clauses satisfied by known cells are dropped. Returns the number of clauses appended.
+inline size_t add_transition_clauses(const std::array<int, 10>& ten_cells, ClauseBuilder& clause, ClauseList& clauses) {
+    size_t before = clauses.size();
+    for (const auto [care, force] : primeImplicants) {
+        bool clause_satisfied = false;
+        for (int bit = 0; bit < 10; bit++) {
+            if (care & (1 << bit)) {
+                int var_index = ten_cells[bit];
+                if (var_index < 2) {
+                    bool force_state = (force & (1 << bit)) != 0;
+                    bool cell_state = (var_index != 0);
+                    if (cell_state == force_state)
+                        clause_satisfied = true;
+                } else {
+                    int sign = (force & (1 << bit)) ? 1 : -1;
+                    clause_satisfied = clause.add(sign * (var_index - 1));
+                }
+                if (clause_satisfied)
+                    break;
+            }
+        }
+        if (!clause_satisfied && !clause.empty())
+            clauses.emplace_back(clause.get());
+        clause.clear();
+    }
+    return clauses.size() - before;
+}
+
 const int OUTSIDE_BOUNDS_INDEX = INT_MIN;  // Special index for out-of-bounds cells
 const int NOT_FOUND_INDEX = -1;    // Special index for uncovered cells
 
@@ -63,10 +96,12 @@ private:
     // var_remap[old_var - 2] = new_var (both use same 0=dead, 1=alive, >=2 convention)
     std::vector<int> var_remap;
     int remapped_num_vars = 0;
+    bool deduplicate = true;
 
     // Precomputed flat arrays (populated during build, indexed by flat_index)
     int x_min, y_min, t_min;
     int sz_x, sz_y, sz_t;
+    std::vector<int> entry_map;             // entry providing each in-bounds cell
     std::vector<int> raw_cell_values;       // result of get_raw_cell_value() for each in-bounds cell
     std::vector<bool> cell_follows_rules;   // result of follows_rules() for each in-bounds cell
     std::vector<int> remapped_cell_values;  // result of get_cell_value() for each in-bounds cell (after dedup)
@@ -88,6 +123,41 @@ private:
         return remapped_cell_values[flat_index(x, y, t)];
     }
 
+    // Call visit(x, y, ten_cells) for each transition from generation t - 1 into an output cell
+    // of the region xr x yr (clipped to the bounds) that follows the rules, in encoding order.
+    // Everything that encodes or inspects transitions goes through here.
+    template <typename Visitor>
+    void for_each_transition(int t, Limits xr, Limits yr, Visitor&& visit) const {
+        auto [xlims, ylims, tlims] = bounds;
+        std::array<int, 10> ten_cells{};
+        for (int y = std::max(yr.first, ylims.first); y <= std::min(yr.second, ylims.second); y++) {
+            for (int x = std::max(xr.first, xlims.first); x <= std::min(xr.second, xlims.second); x++) {
+                // Check if output cell follows rules
+                if (!cell_follows_rules[flat_index(x, y, t)])
+                    continue;
+
+                // Gather neighborhood
+                int i = 0;
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        ten_cells[i++] = remapped_value_at(x + dx, y + dy, t - 1);
+                    }
+                }
+                ten_cells[9] = remapped_value_at(x, y, t);
+
+                visit(x, y, ten_cells);
+            }
+        }
+    }
+
+    // Append the clauses of the transitions from generation t - 1 into generation t, for the
+    // output cells of the region xr x yr (clipped to the bounds)
+    void add_generation_clauses(int t, Limits xr, Limits yr, ClauseBuilder& clause, ClauseList& clauses) const {
+        for_each_transition(t, xr, yr, [&](int, int, const std::array<int, 10>& ten_cells) {
+            add_transition_clauses(ten_cells, clause, clauses);
+        });
+    }
+
 public:
     SearchProblem(Bounds bounds) : bounds(bounds) {}
 
@@ -96,6 +166,19 @@ public:
 
     Bounds get_bounds() const { return bounds; }
 
+    // Whether build() merges the outputs of identical transitions (on by default). Merging
+    // assumes every transition is encoded; drivers that encode generations one at a time turn
+    // it off, since a merge made through a later transition would already bind earlier cells.
+    // The price is the merge's savings: every transition keeps its own output variable, so
+    // those encodings have more variables and clauses than a one-shot build of the same bounds.
+    // Drivers that take the whole encoding up front (enumerate_projected, minimize_population)
+    // work on deduplicated problems.
+    void set_deduplicate(bool on) {
+        deduplicate = on;
+        is_built = false;
+    }
+    bool deduplicates() const { return deduplicate; }
+
     // Add a subpattern entry
     void add_entry(SubPattern* pattern, std::function<bool(Point)> mask) {
         entries.push_back({pattern, mask});
@@ -115,7 +198,8 @@ public:
 
     // Build all subpatterns and compute variable indices
     void build() {
-        auto build_start = std::chrono::high_resolution_clock::now();
+        profiling::ScopedTimer build_timer("SearchProblem::build");
+        memory_stats::PhaseMemory build_memory("SearchProblem::build");
 
         auto [xlims, ylims, tlims] = bounds;
         x_min = xlims.first;  y_min = ylims.first;  t_min = tlims.first;
@@ -125,7 +209,9 @@ public:
         size_t total_cells = size_t(sz_x) * sz_y * sz_t;
 
         // Precompute entry map and validate coverage (single pass over mask functions)
-        std::vector<int> entry_map(total_cells);
+        entry_map.assign(total_cells, NOT_FOUND_INDEX);
+        // Bounding box of the cells each entry provides, passed on as a query window
+        std::vector<Bounds> entry_region(entries.size(), EMPTY_BOUNDS);
         for (size_t fi = 0; fi < total_cells; fi++) {
             int x = x_min + fi % sz_x;
             int y = y_min + (fi / sz_x) % sz_y;
@@ -142,16 +228,27 @@ public:
                 throw std::runtime_error("SearchProblem: not all cells are covered by masks");
             }
             entry_map[fi] = entry_idx;
+            auto& [rx, ry, rt] = entry_region[entry_idx];
+            if (rx.first > rx.second) {
+                rx = {x, x}; ry = {y, y}; rt = {t, t};
+            } else {
+                rx = {std::min(rx.first, x), std::max(rx.second, x)};
+                ry = {std::min(ry.first, y), std::max(ry.second, y)};
+                rt = {std::min(rt.first, t), std::max(rt.second, t)};
+            }
         }
 
-        auto t0 = std::chrono::high_resolution_clock::now();
+        profiling::ScopedTimer pattern_timer("pattern builds");
 
         // Build each subpattern
-        for (auto& entry : entries) {
-            entry.pattern->build();
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (std::get<0>(entry_region[i]).first <= std::get<0>(entry_region[i]).second)
+                entries[i].pattern->restrict_queries(entry_region[i]);
+            entries[i].pattern->build();
         }
 
-        auto t1 = std::chrono::high_resolution_clock::now();
+        pattern_timer.stop();
+        profiling::ScopedTimer dedup_timer("dedup transitions");
 
         // Compute base variable indices for each entry
         entry_base_var.clear();
@@ -187,7 +284,13 @@ public:
         }
 
         // Deduplicate variables based on transition signatures
-        deduplicate_transitions();
+        if (deduplicate) {
+            deduplicate_transitions();
+        } else {
+            var_remap.resize(total_variables);
+            for (int v = 0; v < total_variables; v++) var_remap[v] = v + 2;
+            remapped_num_vars = total_variables;
+        }
 
         // Precompute remapped cell values
         remapped_cell_values.resize(total_cells);
@@ -199,16 +302,18 @@ public:
                 remapped_cell_values[i] = var_remap[raw - 2];
         }
 
-        auto t2 = std::chrono::high_resolution_clock::now();
-
-        auto pattern_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-        auto dedup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
-        auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - build_start).count();
-        std::cout << "  Build phase: " << format_duration(build_ms)
-                  << " (pattern builds: " << format_duration(pattern_ms)
-                  << ", dedup transitions: " << format_duration(dedup_ms)
-                  << ", " << total_variables << " vars before dedup, "
-                  << remapped_num_vars << " after)\n";
+        dedup_timer.stop();
+        build_timer.stop();
+        build_memory.stop();
+        profiling::count("variables before dedup", total_variables);
+        profiling::count("variables", remapped_num_vars);
+
+        if (logging::enabled(logging::Level::INFO))
+            logging::info() << "  Build phase: " << format_duration(build_timer.elapsed_ms())
+                            << " (pattern builds: " << format_duration(pattern_timer.elapsed_ms())
+                            << ", dedup transitions: " << format_duration(dedup_timer.elapsed_ms())
+                            << ", " << total_variables << " vars before dedup, "
+                            << remapped_num_vars << " after, " << build_memory.describe() << ")";
     }
 
     // Get raw (pre-remapping) cell value
@@ -309,6 +414,16 @@ public:
         return remapped_value_at(x, y, t);
     }
 
+    // Whether the cell at a composite position is constrained by the transition from t - 1
+    // (false outside the bounds)
+    bool follows_rules(Point p) const {
+        assert(is_built);
+        auto [x, y, t] = p;
+        if (x < x_min || x >= x_min + sz_x || y < y_min || y >= y_min + sz_y || t < t_min || t >= t_min + sz_t)
+            return false;
+        return cell_follows_rules[flat_index(x, y, t)];
+    }
+
     int num_variables() const {
         assert(is_built);
         return remapped_num_vars;
@@ -317,63 +432,126 @@ public:
     // Get all clauses for the SAT problem
     // Generates GoL transition clauses for all cells in bounds
     ClauseList get_clauses() const {
-        auto clause_start = std::chrono::high_resolution_clock::now();
+        profiling::ScopedTimer clause_timer("SearchProblem::get_clauses");
+        memory_stats::PhaseMemory clause_memory("SearchProblem::get_clauses");
 
         assert(is_built);
         auto [xlims, ylims, tlims] = bounds;
         ClauseList clauses;
         clauses.reserve(remapped_num_vars * 400);  // ~360 clauses/var empirically
         ClauseBuilder clause;
-        std::array<int, 10> ten_cells{};
 
-        for (int t = tlims.first; t < tlims.second; t++) {
+        for (int t = tlims.first; t < tlims.second; t++)
+            add_generation_clauses(t + 1, xlims, ylims, clause, clauses);
+
+        clause_timer.stop();
+        clause_memory.stop();
+        profiling::count("clauses", clauses.size());
+        if (logging::enabled(logging::Level::INFO))
+            logging::info() << "  Clause generation: " << format_duration(clause_timer.elapsed_ms())
+                            << " (" << clauses.size() << " clauses, " << clause_memory.describe() << ")";
+
+        return clauses;
+    }
+
+    // Clauses of the transitions into generation t (tlims.first < t <= tlims.second), in the
+    // order get_clauses() produces them
+    ClauseList get_generation_clauses(int t) const {
+        return get_region_clauses(t, std::get<0>(bounds), std::get<1>(bounds));
+    }
+
+    // Clauses of the transitions into generation t for the output cells in xr x yr
+    ClauseList get_region_clauses(int t, Limits xr, Limits yr) const {
+        assert(is_built);
+        ClauseList clauses;
+        ClauseBuilder clause;
+        add_generation_clauses(t, xr, yr, clause, clauses);
+        return clauses;
+    }
+
+    // Statistics of the encoding get_clauses() produces, computed in a separate pass over the
+    // transitions (see encoding_stats.hpp). The transitions are classified and their clauses
+    // counted in the same walk as transition_heatmap(), so both reports agree with each other
+    // and with get_clauses().
+    EncodingStats encoding_stats() const {
+        assert(is_built);
+        auto [xlims, ylims, tlims] = bounds;
+        EncodingStats stats(remapped_num_vars);
+        TransitionHeatmap heatmap = build_heatmap([&](const ClauseList& transition_clauses) {
+            for (const Clause& c : transition_clauses) stats.add_clause(c);
+        });
+
+        for (int t = tlims.first + 1; t <= tlims.second; t++) {
+            size_t& clauses_into_t = stats.clauses_per_generation[t];
             for (int y = ylims.first; y <= ylims.second; y++) {
                 for (int x = xlims.first; x <= xlims.second; x++) {
-                    // Check if output cell follows rules
-                    if (!cell_follows_rules[flat_index(x, y, t + 1)])
-                        continue;
-
-                    // Gather neighborhood
-                    int i = 0;
-                    for (int dy = -1; dy <= 1; dy++) {
-                        for (int dx = -1; dx <= 1; dx++) {
-                            ten_cells[i++] = remapped_value_at(x + dx, y + dy, t);
-                        }
-                    }
-                    ten_cells[9] = remapped_value_at(x, y, t + 1);
-
-                    // Generate clauses from prime implicants
-                    for (const auto [care, force] : primeImplicants) {
-                        bool clause_satisfied = false;
-                        for (int bit = 0; bit < 10; bit++) {
-                            if (care & (1 << bit)) {
-                                int var_index = ten_cells[bit];
-                                if (var_index < 2) {
-                                    bool force_state = (force & (1 << bit)) != 0;
-                                    bool cell_state = (var_index != 0);
-                                    if (cell_state == force_state)
-                                        clause_satisfied = true;
-                                } else {
-                                    int sign = (force & (1 << bit)) ? 1 : -1;
-                                    clause_satisfied = clause.add(sign * (var_index - 1));
-                                }
-                                if (clause_satisfied)
-                                    break;
-                            }
-                        }
-                        if (!clause_satisfied && !clause.empty())
-                            clauses.emplace_back(clause.get());
-                        clause.clear();
+                    const HeatmapCell& cell = heatmap.at({x, y, t});
+                    clauses_into_t += cell.clauses;
+                    switch (cell.status) {
+                        case TransitionStatus::UNCONSTRAINED: stats.unconstrained++; continue;
+                        case TransitionStatus::KNOWN: stats.fully_known++; break;
+                        case TransitionStatus::ENCODED: stats.distinct_signatures++; break;
+                        case TransitionStatus::DUPLICATE: break;
                     }
+                    stats.transitions++;
                 }
             }
         }
 
-        auto clause_end = std::chrono::high_resolution_clock::now();
-        auto clause_ms = std::chrono::duration_cast<std::chrono::milliseconds>(clause_end - clause_start).count();
-        std::cout << "  Clause generation: " << format_duration(clause_ms)
-                  << " (" << clauses.size() << " clauses)\n";
+        // Origin of each variable: the entry (and cell group) of the raw variables merged into it
+        const int SHARED = -2;
+        std::map<std::pair<int, int>, int> origin_ids;
+        std::vector<int> origin(remapped_num_vars, -1);
+        for (size_t fi = 0; fi < raw_cell_values.size(); fi++) {
+            int raw = raw_cell_values[fi];
+            if (raw < 2 || var_remap[raw - 2] < 2) continue;
+            int entry_idx = int(std::upper_bound(entry_base_var.begin(), entry_base_var.end(), raw) - entry_base_var.begin()) - 1;
+            Point p(x_min + fi % sz_x, y_min + (fi / sz_x) % sz_y, t_min + fi / (sz_x * sz_y));
+            auto key = std::make_pair(entry_idx, entries[entry_idx].pattern->cell_group(p));
+            int id = origin_ids.emplace(key, int(origin_ids.size())).first->second;
+            int& o = origin[var_remap[raw - 2] - 2];
+            o = (o == -1 || o == id) ? id : SHARED;
+        }
+        std::vector<std::string> labels(origin_ids.size());
+        for (const auto& [key, id] : origin_ids)
+            labels[id] = "entry " + std::to_string(key.first) +
+                         (key.second >= 0 ? " / group " + std::to_string(key.second) : "");
+        // variables of cells hidden by the entry masks still take a number
+        for (int o : origin)
+            stats.variables_by_origin[o == -1 ? "unreferenced" : o == SHARED ? "shared" : labels[o]]++;
+        return stats;
+    }
 
-        return clauses;
+    // Per-cell origin of the encoding get_clauses() produces: entry, variables, and the status
+    // and clause count of the transition into each cell (see heatmap.hpp)
+    TransitionHeatmap transition_heatmap() const {
+        return build_heatmap([](const ClauseList&) {});
+    }
+
+private:
+    // The heatmap walk, also handing the clauses of each transition to on_clauses
+    template <typename ClauseVisitor>
+    TransitionHeatmap build_heatmap(ClauseVisitor&& on_clauses) const {
+        assert(is_built);
+        auto [xlims, ylims, tlims] = bounds;
+        TransitionHeatmap heatmap(bounds);
+        for (size_t fi = 0; fi < raw_cell_values.size(); fi++) {
+            HeatmapCell& cell = heatmap.at({x_min + int(fi % sz_x), y_min + int((fi / sz_x) % sz_y), t_min + int(fi / (sz_x * sz_y))});
+            cell.entry = entry_map[fi];
+            cell.raw_variable = raw_cell_values[fi];
+            cell.variable = remapped_cell_values[fi];
+        }
+
+        ClauseList transition_clauses;
+        ClauseBuilder clause;
+        for (int t = tlims.first + 1; t <= tlims.second; t++) {
+            for_each_transition(t, xlims, ylims, [&](int x, int y, const std::array<int, 10>& ten_cells) {
+                transition_clauses.clear();
+                int n = int(add_transition_clauses(ten_cells, clause, transition_clauses));
+                heatmap.record_transition({x, y, t}, ten_cells, n);
+                on_clauses(transition_clauses);
+            });
+        }
+        return heatmap;
     }
 };
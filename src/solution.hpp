@@ -0,0 +1,44 @@
+#pragma once
+/*
+Solution extraction: turn a solver model for a SearchProblem back into cell states,
+e.g. to print, write as RLE, or simulate a found pattern.
+*/
+
+#include <string>
+#include <vector>
+#include "search_problem.hpp"
+#include "solver.hpp"
+#include "bitboard.hpp"
+#include "rle.hpp"
+
+// Truth value of every SAT variable in a model: values[v] for v in 1..num_variables.
+inline std::vector<bool> model_values(const SolverResult& result, int num_variables) {
+    std::vector<bool> values(num_variables + 1, false);
+    for (int lit : result.solution)
+        if (lit > 0 && lit <= num_variables) values[lit] = true;
+    return values;
+}
+
+// Generation t of a solved problem over the problem bounds.
+inline BitPlane extract_generation(const SearchProblem& problem, const std::vector<bool>& values, int t) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    BitPlane plane(xlims.first, ylims.first, xlims.second - xlims.first + 1, ylims.second - ylims.first + 1);
+    for (int y = ylims.first; y <= ylims.second; y++) {
+        for (int x = xlims.first; x <= xlims.second; x++) {
+            int var_idx = problem.get_cell_value(Point(x, y, t));
+            bool alive = var_idx == 1 || (var_idx >= 2 && values[var_idx - 1]);
+            if (alive) plane.set(x, y, true);
+        }
+    }
+    return plane;
+}
+
+inline BitPlane extract_generation(const SearchProblem& problem, const SolverResult& result, int t) {
+    return extract_generation(problem, model_values(result, problem.num_variables()), t);
+}
+
+// Write generation t of a solved problem as an RLE file.
+inline void write_solution_rle(const SearchProblem& problem, const SolverResult& result, int t,
+                               const std::string& filename, bool overwrite = false) {
+    write_rle_file(extract_generation(problem, result, t), filename, overwrite);
+}
@@ -7,12 +7,12 @@
 #include <array>
 #include <memory>
 #include <stdexcept>
-#include <chrono>
-#include <iostream>
 #include <unistd.h>
 #include <sys/wait.h>
 #include "sub_pattern.hpp"  // for ClauseList, Clause
 #include "profiling.hpp"
+#include "memory_stats.hpp"
+#include "logging.hpp"
 
 enum class SolverStatus {
     SAT,
@@ -20,6 +20,14 @@ enum class SolverStatus {
     ERROR
 };
 
+inline const char* solver_status_name(SolverStatus status) {
+    switch (status) {
+        case SolverStatus::SAT: return "SAT";
+        case SolverStatus::UNSAT: return "UNSAT";
+        default: return "ERROR";
+    }
+}
+
 struct SolverResult {
     SolverStatus status;
     std::set<int> solution;  // set of true literals (positive = true, negative = false)
@@ -173,22 +181,32 @@ inline SolverResult solve(const ClauseList& clauses,
                           int num_variables,
                           const std::string& solver_name = "kissat",
                           const BigClauseList& big_clauses = {}) {
-    auto t0 = std::chrono::high_resolution_clock::now();
+    profiling::ScopedTimer solve_timer("solve");
+    memory_stats::PhaseMemory solve_memory("solve");
 
+    profiling::ScopedTimer dimacs_timer("DIMACS gen");
     std::string dimacs = make_dimacs_string(clauses, num_variables, big_clauses);
+    dimacs_timer.stop();
+#ifdef COUNT_ALLOCATIONS
+    // the string grows by doubling; count its final buffer, freed when solve() returns
+    memory_stats::note_allocation(memory_stats::AllocTag::DIMACS, dimacs.capacity());
+#endif
 
-    auto t1 = std::chrono::high_resolution_clock::now();
-
+    profiling::ScopedTimer solver_timer("solver");
     SolverResult result = call_solver(dimacs, solver_name);
-
-    auto t2 = std::chrono::high_resolution_clock::now();
-
-    auto dimacs_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
-    auto solver_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1).count();
-    auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t0).count();
-    std::cout << "  Solve phase: " << format_duration(total_ms)
-              << " (DIMACS gen: " << format_duration(dimacs_ms)
-              << ", solver: " << format_duration(solver_ms) << ")\n";
+    solver_timer.stop();
+    solve_timer.stop();
+    solve_memory.stop();
+#ifdef COUNT_ALLOCATIONS
+    memory_stats::note_deallocation(memory_stats::AllocTag::DIMACS, dimacs.capacity());
+#endif
+
+    if (logging::enabled(logging::Level::INFO))
+        logging::info() << "  Solve phase: " << format_duration(solve_timer.elapsed_ms())
+                        << " (DIMACS gen: " << format_duration(dimacs_timer.elapsed_ms())
+                        << ", solver: " << format_duration(solver_timer.elapsed_ms())
+                        << ", " << solve_memory.describe()
+                        << ", solver peak RSS " << memory_stats::format_bytes(memory_stats::children_peak_rss_bytes()) << ")";
 
     return result;
 }
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include "geometry.hpp"
+#include "memory_stats.hpp"
 
 // Maximum literals in a GoL transition clause (from prime implicant analysis)
 constexpr int MAX_CLAUSE_LEN = 9;
@@ -11,7 +12,7 @@ constexpr int MAX_CLAUSE_LEN = 9;
 // Fixed-size clause for GoL transitions
 // Literals are sorted, unused slots filled with sentinel 0
 using Clause = std::array<int, MAX_CLAUSE_LEN>;
-using ClauseList = std::vector<Clause>;
+using ClauseList = std::vector<Clause, memory_stats::TrackedAllocator<Clause, memory_stats::AllocTag::CLAUSES>>;
 
 // For arbitrary-sized clauses (e.g., "at least one cell alive")
 using BigClause = std::vector<int>;
@@ -113,6 +114,10 @@ public:
     // For VariablePattern: builds union-find structure for variable equivalences
     virtual void build() = 0;
 
+    // Hint that only cells within `region` (composite coordinates) will be queried.
+    // Patterns that evolve lazily use it to limit what they materialize; the default ignores it.
+    virtual void restrict_queries(Bounds /*region*/) {}
+
     // Number of unique variable indices in this pattern (after build).
     // For KnownPattern: always 0
     // For VariablePattern: count of distinct variables after union-find
@@ -135,6 +140,9 @@ public:
     // (i.e., whether the cell at t+1 is constrained by the neighborhood at t)
     virtual bool follows_rules(Point p) const = 0;
 
+    // Cell group of the cell at a position, or -1 if it has none (always -1 for patterns without groups)
+    virtual int cell_group(Point) const { return -1; }
+
     // === Clause generation ===
 
     // Generate all GoL transition clauses internal to this subpattern.
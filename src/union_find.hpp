@@ -7,11 +7,13 @@ Requires a hash function for the key type (default std::hash works for primitive
 
 #include <unordered_map>
 #include <functional>
+#include "memory_stats.hpp"
 
 template<typename T, typename Hash = std::hash<T>>
 class UnionFind {
 private:
-    std::unordered_map<T, T, Hash> parent;
+    std::unordered_map<T, T, Hash, std::equal_to<T>,
+                       memory_stats::TrackedAllocator<std::pair<const T, T>, memory_stats::AllocTag::UNION_FIND>> parent;
 
 public:
     // Reserve space for expected number of elements
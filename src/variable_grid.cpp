@@ -3,15 +3,18 @@
 #include <fstream>
 #include <stdexcept>
 #include <cassert>
-#include <chrono>
 #include <iostream>
 #include "sat_logic.hpp"
 #include "union_find.hpp"
 #include "profiling.hpp"
+#include "memory_stats.hpp"
+#include "logging.hpp"
+#include "file_utils.hpp"
 
 
 VariableGrid construct_variable_grid(const VariablePattern& pattern){
-    auto start = std::chrono::high_resolution_clock::now();
+    profiling::ScopedTimer timer("construct_variable_grid");
+    memory_stats::PhaseMemory memory("construct_variable_grid");
     UnionFind<Point, PointHash> uf;
     Bounds bounds = pattern.get_bounds();
     auto xlims = std::get<0>(bounds);
@@ -105,28 +108,15 @@ VariableGrid construct_variable_grid(const VariablePattern& pattern){
     var_grid.grid = std::move(grid);
     var_grid.follows_rule = std::move(follows_rule);
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    std::cout << "  construct_variable_grid: " << format_duration(ms)
-              << " (" << (next_var_index - 2) << " variables)\n";
+    timer.stop();
+    memory.stop();
+    if (logging::enabled(logging::Level::INFO))
+        logging::info() << "  construct_variable_grid: " << format_duration(timer.elapsed_ms())
+                        << " (" << (next_var_index - 2) << " variables, " << memory.describe() << ")";
 
     return var_grid;
 }
 
-std::ofstream file_checks(const std::string& filename, bool overwrite){
-    if(!overwrite){
-        std::ifstream check(filename);
-        if(check.good()){
-            throw std::runtime_error("File already exists: " + filename);
-        }
-    }
-    std::ofstream file(filename);
-    if(!file.is_open()){
-        throw std::runtime_error("Could not open file for writing: " + filename);
-    }
-    return file;
-}
-
 void write_csv(const VariableGrid& var_grid, const std::string& filename, bool overwrite){
     std::ofstream file = file_checks(filename, overwrite);
 
@@ -157,7 +147,8 @@ void write_csv(const VariableGrid& var_grid, const std::string& filename, bool o
 // Python implementation of both: https://gitlab.com/apgoucher/metasat/-/blob/master/grills.py
 // C implementation of knuth: https://taocp-fun.gitlab.io/v4f6-sat-knuth/pdf/sat-life.pdf
 ClauseList calculate_clauses(const VariableGrid& var_grid, int& num_variables){
-    auto start = std::chrono::high_resolution_clock::now();
+    profiling::ScopedTimer timer("calculate_clauses");
+    memory_stats::PhaseMemory memory("calculate_clauses");
 
     std::array<int, 10> ten_cells{}; // 9 neighborhood + next gen
 
@@ -224,11 +215,13 @@ ClauseList calculate_clauses(const VariableGrid& var_grid, int& num_variables){
         }
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    std::cout << "  calculate_clauses: " << format_duration(ms)
-              << " (" << clauses.size() << " clauses, "
-              << num_variables << " variables)\n";
+    timer.stop();
+    memory.stop();
+    profiling::count("clauses", clauses.size());
+    if (logging::enabled(logging::Level::INFO))
+        logging::info() << "  calculate_clauses: " << format_duration(timer.elapsed_ms())
+                        << " (" << clauses.size() << " clauses, "
+                        << num_variables << " variables, " << memory.describe() << ")";
 
     return clauses;
 }
@@ -25,7 +25,7 @@ The build() method runs union-find to determine which cells share the same varia
 class VariablePattern : public SubPattern {
     private:
         std::vector<CellGroup> cell_groups;
-        std::vector<Cell> cell_list;
+        CellList cell_list;
         Bounds bounds;
         int x_min, y_min, t_min;
         int sz_x, sz_y;
@@ -54,7 +54,7 @@ class VariablePattern : public SubPattern {
         VariablePattern(int width, int height, int max_gen);
 
         // Getters
-        const std::vector<Cell>& get_cells() const { return cell_list; }
+        const CellList& get_cells() const { return cell_list; }
         const std::vector<CellGroup>& get_cell_groups() const { return cell_groups; }
         Cell get_cell(Point p) const;
 
@@ -108,6 +108,11 @@ class VariablePattern : public SubPattern {
             return cell.follows_rules;
         }
 
+        int cell_group(Point p) const override {
+            int idx = cell_index(p);
+            return idx >= 0 ? cell_list[idx].cell_group : DEFAULT_CELL_GROUP;
+        }
+
         ClauseList get_clauses(int base_var_index) const override;
 };
 
@@ -0,0 +1,194 @@
+#pragma once
+/*
+Verification of solver models by direct simulation, independent of the clause encoding.
+
+Each model is turned back into cell states with extract_generation() and checked with the
+bitboard engine:
+- ALL_GENERATIONS: every generation is extracted, and every rule-following cell of generation
+  t + 1 must equal life_step() of the model's generation t (cells outside the bounds are dead,
+  as in the encoding).
+- GENERATION_ZERO: only generation 0 is extracted. It is evolved in an unbounded plane and the
+  constraints are checked on that free evolution, i.e. whether the found pattern really behaves
+  as declared once it is no longer held by the search box.
+
+Declared constraints are affine maps (x, y, t) -> T(x, y, t) under which the state must be
+invariant, e.g. {1, 0, 0, 1, 0, 0, p} for period p or {1, 0, 0, -1, 1, 0, 2} for the LWSS
+glide-reflection. They are checked in both modes.
+
+verify_models() spreads a batch of models over worker threads; the rule masks are computed once
+and shared read-only.
+*/
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include "search_problem.hpp"
+#include "solution.hpp"
+#include "bitboard.hpp"
+
+enum class VerifyMode {
+    ALL_GENERATIONS,
+    GENERATION_ZERO
+};
+
+struct SymmetryConstraint {
+    AffineTransf transf;
+    std::function<bool(Point)> mask;  // cells (composite coordinates) to check; empty = all in bounds
+};
+
+struct VerifyResult {
+    bool valid = true;
+    std::string error;  // first violation found, empty if valid
+};
+
+namespace verify_detail {
+
+inline std::string point_str(Point p) {
+    auto [x, y, t] = p;
+    return "(" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(t) + ")";
+}
+
+// Rule-following cells of each generation as planes over the problem bounds.
+inline std::vector<BitPlane> rule_masks(const SearchProblem& problem) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    std::vector<BitPlane> masks;
+    for (int t = tlims.first; t <= tlims.second; t++) {
+        BitPlane mask(xlims.first, ylims.first, xlims.second - xlims.first + 1, ylims.second - ylims.first + 1);
+        for (int y = ylims.first; y <= ylims.second; y++)
+            for (int x = xlims.first; x <= xlims.second; x++)
+                if (problem.follows_rules(Point(x, y, t))) mask.set(x, y, true);
+        masks.push_back(std::move(mask));
+    }
+    return masks;
+}
+
+// First cell where `state` breaks one of the constraints, checked from every masked cell in bounds.
+// `in_range` says whether an image can be evaluated at all.
+inline VerifyResult check_constraints(const Bounds& bounds, const std::vector<SymmetryConstraint>& constraints,
+                                      const std::function<bool(Point)>& state,
+                                      const std::function<bool(Point)>& in_range) {
+    auto [xlims, ylims, tlims] = bounds;
+    for (const SymmetryConstraint& constraint : constraints) {
+        for (int t = tlims.first; t <= tlims.second; t++) {
+            for (int y = ylims.first; y <= ylims.second; y++) {
+                for (int x = xlims.first; x <= xlims.second; x++) {
+                    Point p(x, y, t);
+                    if (constraint.mask && !constraint.mask(p)) continue;
+                    Point image = transform(constraint.transf, p);
+                    if (!in_range(image)) continue;
+                    if (state(p) != state(image))
+                        return {false, "constraint violated: " + point_str(p) + " -> " + point_str(image)};
+                }
+            }
+        }
+    }
+    return {};
+}
+
+inline VerifyResult verify_all_generations(const SearchProblem& problem, const std::vector<bool>& values,
+                                           const std::vector<SymmetryConstraint>& constraints,
+                                           const std::vector<BitPlane>& masks) {
+    Bounds bounds = problem.get_bounds();
+    auto [xlims, ylims, tlims] = bounds;
+    std::vector<BitPlane> gens;
+    for (int t = tlims.first; t <= tlims.second; t++)
+        gens.push_back(extract_generation(problem, values, t));
+
+    for (size_t i = 0; i + 1 < gens.size(); i++) {
+        BitPlane next = life_step(gens[i]);
+        const BitPlane& actual = gens[i + 1];
+        const BitPlane& mask = masks[i + 1];
+        for (int ly = 0; ly < next.height; ly++) {
+            for (int k = 0; k < next.stride; k++) {
+                uint64_t bad = (next.row(ly)[k] ^ actual.row(ly)[k]) & mask.row(ly)[k];
+                if (!bad) continue;
+                Point p(next.x0 + 64 * k + __builtin_ctzll(bad), next.y0 + ly, tlims.first + int(i) + 1);
+                return {false, "rule violated at " + point_str(p)};
+            }
+        }
+    }
+
+    auto state = [&](Point p) {
+        auto [x, y, t] = p;
+        return gens[t - tlims.first].get(x, y);
+    };
+    auto in_range = [&](Point p) { return in_limits(p, bounds); };
+    return check_constraints(bounds, constraints, state, in_range);
+}
+
+inline VerifyResult verify_generation_zero(const SearchProblem& problem, const std::vector<bool>& values,
+                                           const std::vector<SymmetryConstraint>& constraints) {
+    Bounds bounds = problem.get_bounds();
+    auto [xlims, ylims, tlims] = bounds;
+    int gens = tlims.second - tlims.first;
+    // Light speed is one cell per generation, so this margin keeps the evolution exact
+    std::vector<BitPlane> history = {extract_generation(problem, values, tlims.first).padded(gens + 1)};
+    for (int i = 0; i < gens; i++)
+        history.push_back(life_step(history.back()));
+
+    auto state = [&](Point p) {
+        auto [x, y, t] = p;
+        return history[t - tlims.first].get(x, y);
+    };
+    auto in_range = [&](Point p) {
+        int t = std::get<2>(p);
+        return t >= tlims.first && t <= tlims.second;
+    };
+    return check_constraints(bounds, constraints, state, in_range);
+}
+
+}  // namespace verify_detail
+
+// Check a batch of models (values[v] for SAT variable v, as from model_values()) on `num_threads`
+// worker threads (0 = hardware concurrency). Results are in model order.
+// Constraint masks are called concurrently and must be thread-safe.
+inline std::vector<VerifyResult> verify_models(const SearchProblem& problem,
+                                               const std::vector<std::vector<bool>>& models,
+                                               const std::vector<SymmetryConstraint>& constraints = {},
+                                               VerifyMode mode = VerifyMode::ALL_GENERATIONS,
+                                               int num_threads = 0) {
+    using namespace verify_detail;
+    std::vector<VerifyResult> results(models.size());
+    if (models.empty()) return results;
+    std::vector<BitPlane> masks;
+    if (mode == VerifyMode::ALL_GENERATIONS) masks = rule_masks(problem);
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < models.size(); i = next++) {
+            if (mode == VerifyMode::ALL_GENERATIONS)
+                results[i] = verify_all_generations(problem, models[i], constraints, masks);
+            else
+                results[i] = verify_generation_zero(problem, models[i], constraints);
+        }
+    };
+
+    if (num_threads <= 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = std::min<size_t>(num_threads, models.size());
+    std::vector<std::thread> threads;
+    for (int i = 1; i < num_threads; i++) threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads) thread.join();
+    return results;
+}
+
+inline std::vector<VerifyResult> verify_models(const SearchProblem& problem,
+                                               const std::vector<SolverResult>& results,
+                                               const std::vector<SymmetryConstraint>& constraints = {},
+                                               VerifyMode mode = VerifyMode::ALL_GENERATIONS,
+                                               int num_threads = 0) {
+    std::vector<std::vector<bool>> models;
+    models.reserve(results.size());
+    for (const SolverResult& result : results)
+        models.push_back(model_values(result, problem.num_variables()));
+    return verify_models(problem, models, constraints, mode, num_threads);
+}
+
+inline VerifyResult verify_model(const SearchProblem& problem, const std::vector<bool>& values,
+                                 const std::vector<SymmetryConstraint>& constraints = {},
+                                 VerifyMode mode = VerifyMode::ALL_GENERATIONS) {
+    return verify_models(problem, std::vector<std::vector<bool>>{values}, constraints, mode, 1)[0];
+}
@@ -0,0 +1,170 @@
+#pragma once
+/*
+Iterative widening of the spatial box on an incremental solver: instead of rebuilding the
+VariablePattern and SearchProblem for every box size, the problem is built once for the largest
+box and one live solver is grown into it. At each step every cell outside the current box is
+forced dead behind an activation literal that is only assumed for that step's solve; on UNSAT the
+literal is retired, the box grows by `step` cells on each side and only the transitions of the
+newly reached cells are added.
+
+The boxes a search can reach are known up front, so each cell outside the start box is forced dead
+once, by the literal of the ring between the two boxes that first separate it from the box, and
+each ring's literal implies the next one's: assuming one literal kills everything outside its box,
+and the dead-cell clauses total one per cell rather than one per cell and step.
+
+    SearchProblem problem(bounds);            // bounds are the largest box to try
+    problem.add_entry(...);
+    problem.set_deduplicate(false);           // required, at the cost of the transition merge
+    problem.build();
+    CdclSolver solver;
+    solver.add_clause(generation_alive_clause(problem, 0));   // constraints for every box
+    WideningResult found = iterative_widening(problem, solver, {4, 5}, {4, 5});
+
+With everything outside the box dead, only the transitions of cells within one cell of the box can
+be violated, so those are the ones encoded. The search stops at the first satisfiable box, or early
+when a refutation did not need the dead outside: the encoded transitions alone are then
+unsatisfiable, and larger boxes only add transitions. Either way it stops once the box is the
+whole of the bounds.
+
+As in deepening.hpp, the problem is built without transition dedup, since transitions reached by
+a later box could merge cells of earlier ones; every box pays for the unmerged encoding.
+*/
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <cstdint>
+#include "search_problem.hpp"
+#include "incremental_solver.hpp"
+#include "profiling.hpp"
+#include "logging.hpp"
+
+struct WideningResult {
+    SolverStatus status = SolverStatus::UNSAT;  // SAT in the box, or UNSAT in every box up to it
+    Limits xlims = EMPTY_LIMITS;                // box of the last step
+    Limits ylims = EMPTY_LIMITS;
+    int steps = 0;
+    SolverResult solution;                      // model over the problem variables when SAT
+};
+
+// `limits` grown by `by` on each side, clipped to `within`
+inline Limits widen_limits(Limits limits, int by, Limits within) {
+    return {std::max(limits.first - by, within.first), std::min(limits.second + by, within.second)};
+}
+
+// The non-empty rectangles covering outer_x x outer_y but not inner_x x inner_y (the inner region
+// lies within the outer one, or is empty)
+inline std::vector<std::pair<Limits, Limits>> ring_strips(Limits outer_x, Limits outer_y, Limits inner_x,
+                                                          Limits inner_y) {
+    std::vector<std::pair<Limits, Limits>> strips;
+    if (inner_x.first > inner_x.second || inner_y.first > inner_y.second) {
+        strips.push_back({outer_x, outer_y});
+    } else {
+        strips.push_back({outer_x, {outer_y.first, inner_y.first - 1}});
+        strips.push_back({outer_x, {inner_y.second + 1, outer_y.second}});
+        strips.push_back({{outer_x.first, inner_x.first - 1}, inner_y});
+        strips.push_back({{inner_x.second + 1, outer_x.second}, inner_y});
+    }
+    strips.erase(std::remove_if(strips.begin(), strips.end(), [](const std::pair<Limits, Limits>& strip) {
+        return strip.first.first > strip.first.second || strip.second.first > strip.second.second;
+    }), strips.end());
+    return strips;
+}
+
+// Add the transitions of the output cells in outer_x x outer_y but not in inner_x x inner_y (the
+// inner region lies within the outer one, or is empty). Returns the number of clauses added.
+inline size_t add_ring_transitions(const SearchProblem& problem, IncrementalSolver& solver, Limits outer_x,
+                                   Limits outer_y, Limits inner_x, Limits inner_y) {
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    std::vector<std::pair<Limits, Limits>> strips = ring_strips(outer_x, outer_y, inner_x, inner_y);
+    size_t added = 0;
+    for (int t = tlims.first + 1; t <= tlims.second; t++) {
+        for (const auto& [xr, yr] : strips) {
+            ClauseList clauses = problem.get_region_clauses(t, xr, yr);
+            solver.add_clauses(clauses);
+            added += clauses.size();
+        }
+    }
+    return added;
+}
+
+inline WideningResult iterative_widening(const SearchProblem& problem, IncrementalSolver& solver,
+                                         Limits start_x, Limits start_y, int step = 1) {
+    if (problem.deduplicates())
+        throw std::runtime_error("iterative_widening: build the SearchProblem with set_deduplicate(false)");
+    if (step < 1)
+        throw std::runtime_error("iterative_widening: step must be positive");
+    profiling::ScopedTimer timer("iterative_widening");
+
+    auto [xlims, ylims, tlims] = problem.get_bounds();
+    Limits box_x = widen_limits(start_x, 0, xlims), box_y = widen_limits(start_y, 0, ylims);
+    if (box_x.first > box_x.second || box_y.first > box_y.second)
+        throw std::runtime_error("iterative_widening: the start box does not meet the bounds");
+    solver.reserve_variables(problem.num_variables());
+
+    // boxes[k] is the box of step k; the last one is the whole of the bounds
+    std::vector<std::pair<Limits, Limits>> boxes = {{box_x, box_y}};
+    while (boxes.back() != std::make_pair(xlims, ylims))
+        boxes.push_back({widen_limits(boxes.back().first, step, xlims), widen_limits(boxes.back().second, step, ylims)});
+
+    // dead[k]: every cell outside boxes[k] is dead. It forces the ring up to boxes[k + 1] and
+    // implies dead[k + 1] for the rest.
+    std::vector<int> dead(boxes.size() - 1);
+    for (int& d : dead) d = solver.new_variable();
+    std::vector<size_t> forced_in(problem.num_variables() + 1, SIZE_MAX);  // last ring forcing each variable
+    for (size_t k = 0; k < dead.size(); k++) {
+        if (k + 1 < dead.size()) solver.add_clause({-dead[k], dead[k + 1]});
+        auto [inner_x, inner_y] = boxes[k];
+        auto [outer_x, outer_y] = boxes[k + 1];
+        for (const auto& [xr, yr] : ring_strips(outer_x, outer_y, inner_x, inner_y)) {
+            for (int t = tlims.first; t <= tlims.second; t++) {
+                for (int y = yr.first; y <= yr.second; y++) {
+                    for (int x = xr.first; x <= xr.second; x++) {
+                        int v = problem.get_cell_value({x, y, t});
+                        if (v == 1) {
+                            solver.add_clause({-dead[k]});
+                        } else if (v >= 2 && forced_in[v - 1] != k) {
+                            forced_in[v - 1] = k;
+                            solver.add_clause({-dead[k], -(v - 1)});
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    WideningResult result;
+    Limits encoded_x = EMPTY_LIMITS, encoded_y = EMPTY_LIMITS;
+    for (size_t k = 0; k < boxes.size(); k++) {
+        profiling::ScopedTimer box_timer("box");
+        std::tie(box_x, box_y) = boxes[k];
+        result.steps++;
+        result.xlims = box_x;
+        result.ylims = box_y;
+
+        Limits reach_x = widen_limits(box_x, 1, xlims), reach_y = widen_limits(box_y, 1, ylims);
+        size_t added = add_ring_transitions(problem, solver, reach_x, reach_y, encoded_x, encoded_y);
+        encoded_x = reach_x;
+        encoded_y = reach_y;
+
+        // nothing is left outside the last box (a backend could report an unused literal failed)
+        bool last = k + 1 == boxes.size();
+        result.status = last ? solver.solve() : solver.solve({dead[k]});
+        box_timer.stop();
+        logging::info() << "  Box " << (box_x.second - box_x.first + 1) << "x" << (box_y.second - box_y.first + 1)
+                        << ": " << solver_status_name(result.status) << " in "
+                        << format_duration(box_timer.elapsed_ms()) << " (" << added << " transition clauses added)";
+
+        if (result.status == SolverStatus::SAT) {
+            result.solution = solver.model(problem.num_variables());
+            break;
+        }
+        if (result.status == SolverStatus::ERROR || last) break;
+        bool needed_box = solver.failed(dead[k]);
+        solver.add_clause({-dead[k]});  // release the dead outside for good
+        if (!needed_box) break;
+    }
+    return result;
+}
@@ -0,0 +1,60 @@
+#include <cassert>
+#include <iostream>
+#include "../src/known_pattern.cpp"
+#include "../src/apgcode.hpp"
+
+void check_encoding(const std::string& rle, const std::string& expected) {
+    std::string code = encode_apgcode(parse_rle(rle));
+    if (code != expected) {
+        std::cerr << "  MISMATCH: " << rle << " encoded as " << code << ", expected " << expected << "\n";
+        assert(false);
+    }
+}
+
+void test_encode() {
+    check_encoding("2o$2o!", "xs4_33");
+    check_encoding("b2o$o2bo$b2o!", "xs6_696");
+    check_encoding("2o$obo$bo!", "xs5_253");
+    check_encoding("3o!", "xp2_7");
+    check_encoding("bo$2bo$3o!", "xq4_153");
+    check_encoding("bo2bo$o4b$o3bo$4o!", "xq4_6frc");
+    check_encoding("2bo4bo$2ob4ob2o$2bo4bo!", "xp15_4r4z4r4");
+    check_encoding(R"(x = 13, y = 13, rule = B3/S23
+2b3o3b3o2$o4bobo4bo$o4bobo4bo$o4bobo4bo$2b3o3b3o2$2b3o3b3o$o4bobo4bo$o
+4bobo4bo$o4bobo4bo2$2b3o3b3o!)", "xp3_co9nas0san9oczgoldlo0oldlogz1047210127401");
+    std::cout << "PASSED: test_encode\n";
+}
+
+// Decoding then re-encoding gives back the same code, and the decoded pattern evolves correctly
+void test_decode_round_trip() {
+    for (std::string code : {"xs4_33", "xs6_696", "xq4_153", "xq4_6frc", "xp15_4r4z4r4",
+                             "xp3_co9nas0san9oczgoldlo0oldlogz1047210127401"}) {
+        assert(encode_apgcode(decode_apgcode(code)) == code);
+    }
+
+    // 'y' runs: 4 + 0 empty columns, then column value 24 (rows 3 and 4)
+    BitPlane plane = decode_apgcode("xs4_y0oo");
+    assert(plane.width == 6 && plane.height == 5);
+    assert(plane.get(4, 3) && plane.get(4, 4) && plane.get(5, 3) && plane.get(5, 4));
+    assert(plane.population() == 4);
+
+    KnownPattern glider(decode_apgcode("xq4_153"), 4);
+    assert(encode_apgcode(glider.get_generation(3)) == "xq4_153");
+
+    bool threw = false;
+    try {
+        decode_apgcode("ov_s4");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "PASSED: test_decode_round_trip\n";
+}
+
+int main() {
+    test_encode();
+    test_decode_round_trip();
+
+    std::cout << "\nAll apgcode tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <iostream>
+#include <cassert>
+#include "../src/variable_pattern.hpp"
+#include "../src/known_pattern.cpp"
+#include "../src/cardinality.hpp"
+#include "../src/enumeration.hpp"
+#include "../src/deepening.hpp"
+#include "../src/cdcl.hpp"
+
+const CardinalityEncoding ENCODINGS[] = {CardinalityEncoding::SEQUENTIAL_COUNTER, CardinalityEncoding::TOTALIZER,
+                                         CardinalityEncoding::SORTING_NETWORK, CardinalityEncoding::AUTO};
+
+// Every input assignment is allowed exactly when lo <= count <= hi, for all bounds and encodings
+void test_exhaustive_bounds() {
+    size_t checked = 0;
+    for (int n = 1; n <= 6; n++) {
+        std::vector<int> literals;
+        for (int v = 1; v <= n; v++) literals.push_back(v % 2 ? v : -v);  // mixed signs
+        for (int lo = -1; lo <= n + 1; lo++) {
+            for (int hi = lo - 1; hi <= n + 1; hi++) {
+                for (CardinalityEncoding encoding : ENCODINGS) {
+                    CardinalityEncoder encoder(n);
+                    BigClauseList clauses;
+                    encoder.encode(clauses, literals, lo, hi, encoding);
+                    CdclSolver solver;
+                    solver.reserve_variables(encoder.num_variables());
+                    solver.add_clauses(clauses);
+                    for (uint32_t bits = 0; bits < (1u << n); bits++) {
+                        std::vector<int> inputs;
+                        int count = 0;
+                        for (int v = 1; v <= n; v++) {
+                            bool value = (bits >> (v - 1)) & 1;
+                            inputs.push_back(value ? v : -v);
+                            count += value == (literals[v - 1] > 0);
+                        }
+                        bool allowed = lo <= count && count <= hi;
+                        assert((solver.solve(inputs) == SolverStatus::SAT) == allowed);
+                        checked++;
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "PASSED: test_exhaustive_bounds (" << checked << " assignments)\n";
+}
+
+// A literal listed twice counts twice
+void test_repeated_literals() {
+    for (CardinalityEncoding encoding : ENCODINGS) {
+        CardinalityEncoder encoder(2);
+        BigClauseList clauses;
+        encoder.at_most(clauses, {1, 1, 2}, 1, encoding);
+        CdclSolver solver;
+        solver.add_clauses(clauses);
+        assert(solver.solve({2}) == SolverStatus::SAT && !solver.value(1));
+        assert(solver.solve({1}) == SolverStatus::UNSAT);
+    }
+    std::cout << "PASSED: test_repeated_literals\n";
+}
+
+void test_choice_by_size() {
+    using CE = CardinalityEncoding;
+    assert(CardinalityEncoder::choose(400, 0, 1) == CE::SEQUENTIAL_COUNTER);
+    assert(CardinalityEncoder::choose(400, 0, 200) != CE::SEQUENTIAL_COUNTER);
+    assert(CardinalityEncoder::choose(400, 399, 400) == CE::SEQUENTIAL_COUNTER);
+    for (auto [n, lo, hi] : {std::tuple{400, 0, 1}, {400, 0, 20}, {400, 150, 250}, {64, 10, 40}}) {
+        CE chosen = CardinalityEncoder::choose(n, lo, hi);
+        size_t best = CardinalityEncoder::estimated_clauses(chosen, n, lo, hi);
+        std::vector<int> literals(n);
+        for (int v = 1; v <= n; v++) literals[v - 1] = v;
+        for (CE encoding : {CE::SEQUENTIAL_COUNTER, CE::TOTALIZER, CE::SORTING_NETWORK}) {
+            assert(best <= CardinalityEncoder::estimated_clauses(encoding, n, lo, hi));
+            // estimates are close to what the encoders produce
+            CardinalityEncoder encoder(n);
+            BigClauseList clauses;
+            encoder.encode(clauses, literals, lo, hi, encoding);
+            size_t estimate = CardinalityEncoder::estimated_clauses(encoding, n, lo, hi);
+            assert(clauses.size() <= estimate + 2 && estimate <= clauses.size() * 2 + 2);
+        }
+        std::cout << "  " << n << " literals, " << lo << ".." << hi << ": " << cardinality_encoding_name(chosen)
+                  << " (" << best << " clauses)\n";
+    }
+    std::cout << "PASSED: test_choice_by_size\n";
+}
+
+// Totalizer outputs bounded through assumptions
+void test_totalizer_outputs() {
+    const int n = 8;
+    std::vector<int> literals;
+    for (int v = 1; v <= n; v++) literals.push_back(v);
+    CardinalityEncoder encoder(n);
+    BigClauseList clauses;
+    std::vector<int> out = encoder.totalizer(clauses, literals);
+    assert(int(out.size()) == n);
+    CdclSolver solver;
+    solver.add_clauses(clauses);
+    for (int k = 0; k < n; k++) {
+        std::vector<int> assumptions = {-out[k]};
+        for (int v = 1; v <= k + 1; v++) assumptions.push_back(v);
+        assert(solver.solve(assumptions) == SolverStatus::UNSAT);  // k + 1 true, but at most k
+        assumptions.pop_back();
+        assert(solver.solve(assumptions) == SolverStatus::SAT);
+        int count = 0;
+        for (int v = 1; v <= n; v++) count += solver.value(v);
+        assert(count <= k);
+        assert(solver.solve({out[k]}) == SolverStatus::SAT);  // downward: at least k + 1
+        count = 0;
+        for (int v = 1; v <= n; v++) count += solver.value(v);
+        assert(count >= k + 1);
+    }
+    std::cout << "PASSED: test_totalizer_outputs\n";
+}
+
+// Still lifes in a 4x4 area by population, against an exhaustive scan
+void test_still_life_populations() {
+    Bounds bounds({0, 5}, {0, 5}, {0, 1});
+    VariablePattern pattern(bounds);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(bounds);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.build();
+
+    std::vector<int> by_population(17, 0);
+    for (uint32_t bits = 1; bits < (1u << 16); bits++) {
+        BitPlane plane(0, 0, 6, 6);
+        for (int i = 0; i < 16; i++) plane.set(1 + i % 4, 1 + i / 4, (bits >> i) & 1);
+        BitPlane next = life_step(plane);
+        bool still = true;
+        for (int y = -1; y <= 6 && still; y++)
+            for (int x = -1; x <= 6 && still; x++) still = next.get(x, y) == plane.get(x, y);
+        if (still) by_population[plane.population()]++;
+    }
+
+    CellSum gen0 = generation_sum(problem, 0);
+    assert(gen0.literals.size() == 16 && gen0.alive == 0);
+    for (auto [lo, hi] : {std::pair{1, 4}, {5, 6}, {7, INT_MAX}, {8, 8}}) {
+        for (CardinalityEncoding encoding : ENCODINGS) {
+            CardinalityEncoder encoder(problem.num_variables());
+            BigClauseList big_clauses = shifted_copy_constraints(problem, 1, 0, 0);
+            add_population_bounds(big_clauses, encoder, gen0, lo, hi, encoding);
+            CdclSolver solver;
+            solver.reserve_variables(encoder.num_variables());
+            solver.add_clauses(problem.get_clauses());
+            solver.add_clauses(big_clauses);
+            EnumerationResult result = enumerate_projected(solver, generation_variables(problem, 0),
+                                                           problem.num_variables(), [&](const ProjectedSolution& s) {
+                int population = extract_generation(problem, s.model, 0).population();
+                assert(lo <= population && population <= hi);
+                return true;
+            });
+            int expected = 0;
+            for (int p = std::max(lo, 0); p <= std::min(hi, 16); p++) expected += by_population[p];
+            assert(int(result.solutions) == expected);
+        }
+    }
+
+    // known live cells count toward the population
+    VariablePattern seeded(bounds);
+    seeded.set_known_if(false, [&](const Cell& c) { return seeded.is_boundary(c.position); });
+    seeded.set_known_if(true, [](const Cell& c) { auto [x, y, t] = c.position; return t == 0 && x == 1 && y == 1; });
+    SearchProblem seeded_problem(bounds);
+    seeded_problem.add_entry(&seeded, [](Point) { return true; });
+    seeded_problem.build();
+    CellSum sum = generation_sum(seeded_problem, 0);
+    assert(sum.alive == 1 && sum.literals.size() == 15);
+    CardinalityEncoder encoder(seeded_problem.num_variables());
+    BigClauseList big_clauses;
+    add_population_bounds(big_clauses, encoder, sum, 0, 0);
+    assert(big_clauses.size() == 1 && big_clauses[0].empty());
+    std::cout << "PASSED: test_still_life_populations\n";
+}
+
+int main() {
+    test_exhaustive_bounds();
+    test_repeated_literals();
+    test_choice_by_size();
+    test_totalizer_outputs();
+    test_still_life_populations();
+
+    std::cout << "\nAll cardinality tests passed!\n";
+    return 0;
+}
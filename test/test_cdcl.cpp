@@ -0,0 +1,186 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include "../src/cdcl.hpp"
+
+using Formula = std::vector<std::vector<int>>;
+
+bool satisfies(const Formula& formula, const std::vector<bool>& values) {
+    for (const auto& clause : formula) {
+        bool sat = false;
+        for (int lit : clause) sat |= values[std::abs(lit)] == (lit > 0);
+        if (!sat) return false;
+    }
+    return true;
+}
+
+bool brute_force(const Formula& formula, int n) {
+    std::vector<bool> values(n + 1);
+    for (uint32_t bits = 0; bits < (1u << n); bits++) {
+        for (int v = 1; v <= n; v++) values[v] = (bits >> (v - 1)) & 1;
+        if (satisfies(formula, values)) return true;
+    }
+    return false;
+}
+
+std::vector<bool> model_of(const CdclSolver& solver, int n) {
+    std::vector<bool> values(n + 1);
+    for (int v = 1; v <= n; v++) values[v] = solver.value(v);
+    return values;
+}
+
+// Random 3-SAT around the threshold, checked against exhaustive search
+void test_random_3sat() {
+    std::mt19937 rng(1);
+    const int n = 12;
+    int sat = 0, unsat = 0;
+    for (int round = 0; round < 200; round++) {
+        Formula formula;
+        std::uniform_int_distribution<int> var(1, n), sign(0, 1);
+        for (int i = 0; i < 52; i++) {
+            std::vector<int> clause;
+            for (int k = 0; k < 3; k++) clause.push_back(sign(rng) ? var(rng) : -var(rng));
+            formula.push_back(clause);
+        }
+        CdclSolver solver;
+        for (const auto& clause : formula) solver.add_clause(clause);
+        SolverStatus status = solver.solve();
+        bool expected = brute_force(formula, n);
+        assert((status == SolverStatus::SAT) == expected);
+        if (expected) {
+            assert(satisfies(formula, model_of(solver, n)));
+            sat++;
+        } else {
+            unsat++;
+        }
+    }
+    assert(sat > 0 && unsat > 0);
+    std::cout << "PASSED: test_random_3sat (" << sat << " SAT, " << unsat << " UNSAT)\n";
+}
+
+// Pigeonhole: n + 1 pigeons into n holes is UNSAT and needs real conflict analysis
+void test_pigeonhole() {
+    const int holes = 6, pigeons = holes + 1;
+    auto p = [&](int i, int j) { return i * holes + j + 1; };
+    CdclSolver solver;
+    for (int i = 0; i < pigeons; i++) {
+        std::vector<int> clause;
+        for (int j = 0; j < holes; j++) clause.push_back(p(i, j));
+        solver.add_clause(clause);
+    }
+    for (int j = 0; j < holes; j++)
+        for (int a = 0; a < pigeons; a++)
+            for (int b = a + 1; b < pigeons; b++) solver.add_clause({-p(a, j), -p(b, j)});
+    assert(solver.solve() == SolverStatus::UNSAT);
+    assert(solver.stats().conflicts > 0);
+    // unsatisfiable for good: later solves stay UNSAT without assumptions to blame
+    assert(solver.solve({p(0, 0)}) == SolverStatus::UNSAT);
+    assert(!solver.failed(p(0, 0)));
+    std::cout << "PASSED: test_pigeonhole (" << solver.stats().conflicts << " conflicts)\n";
+}
+
+void test_assumptions() {
+    CdclSolver solver;
+    // a -> b, b -> c, and c -> not d
+    solver.add_clause({-1, 2});
+    solver.add_clause({-2, 3});
+    solver.add_clause({-3, -4});
+
+    assert(solver.solve({1}) == SolverStatus::SAT);
+    assert(solver.value(1) && solver.value(2) && solver.value(3) && !solver.value(4));
+
+    assert(solver.solve({5, 1, 4}) == SolverStatus::UNSAT);
+    assert(solver.failed(1) && solver.failed(4));
+    assert(!solver.failed(5));
+
+    // assumptions do not stick
+    assert(solver.solve({4}) == SolverStatus::SAT);
+    assert(!solver.value(1) && solver.value(4));
+
+    // contradictory assumptions
+    assert(solver.solve({2, -2}) == SolverStatus::UNSAT);
+    assert(solver.failed(2) && solver.failed(-2));
+    std::cout << "PASSED: test_assumptions\n";
+}
+
+// Activation literals switch clause groups on and off between solves
+void test_incremental() {
+    CdclSolver solver;
+    solver.reserve_variables(3);
+    int act = solver.new_variable();
+    assert(act == 4 && solver.num_variables() == 4);
+
+    solver.add_clause({1, 2, 3});
+    solver.add_clause({-act, -1});
+    solver.add_clause({-act, -2});
+    assert(solver.solve({act}) == SolverStatus::SAT);
+    assert(solver.value(3));
+
+    solver.add_clause({-act, -3});
+    assert(solver.solve({act}) == SolverStatus::UNSAT);
+    assert(solver.failed(act));
+
+    // retire the group; the remaining clauses are still satisfiable
+    solver.add_clause({-act});
+    assert(solver.solve() == SolverStatus::SAT);
+    assert(solver.value(1) || solver.value(2) || solver.value(3));
+
+    ClauseList clauses = {make_clause({-1}), make_clause({-2})};
+    solver.add_clauses(clauses);
+    solver.add_clauses(BigClauseList{{-3}});
+    assert(solver.solve() == SolverStatus::UNSAT);
+
+    CdclSolver trivial;
+    trivial.add_clause({1});
+    assert(trivial.solve() == SolverStatus::SAT);
+    SolverResult model = trivial.model(1);
+    assert(model.status == SolverStatus::SAT && model.solution == std::set<int>{1});
+    std::cout << "PASSED: test_incremental\n";
+}
+
+// Repeated solves under different assumptions on one instance, checked by brute force
+void test_assumption_sequence() {
+    std::mt19937 rng(7);
+    const int n = 10;
+    std::uniform_int_distribution<int> var(1, n), sign(0, 1);
+    Formula formula;
+    CdclSolver solver;
+    for (int i = 0; i < 30; i++) {
+        std::vector<int> clause;
+        for (int k = 0; k < 3; k++) clause.push_back(sign(rng) ? var(rng) : -var(rng));
+        formula.push_back(clause);
+        solver.add_clause(clause);
+    }
+    for (int round = 0; round < 100; round++) {
+        std::vector<int> assumptions;
+        Formula with_units = formula;
+        for (int k = 0; k < 3; k++) {
+            int lit = sign(rng) ? var(rng) : -var(rng);
+            assumptions.push_back(lit);
+            with_units.push_back({lit});
+        }
+        SolverStatus status = solver.solve(assumptions);
+        assert((status == SolverStatus::SAT) == brute_force(with_units, n));
+        if (status == SolverStatus::SAT) {
+            assert(satisfies(with_units, model_of(solver, n)));
+        } else {
+            // the failed assumptions alone are already inconsistent with the formula
+            Formula core = formula;
+            for (int lit : assumptions)
+                if (solver.failed(lit)) core.push_back({lit});
+            assert(!brute_force(core, n));
+        }
+    }
+    std::cout << "PASSED: test_assumption_sequence\n";
+}
+
+int main() {
+    test_random_3sat();
+    test_pigeonhole();
+    test_assumptions();
+    test_incremental();
+    test_assumption_sequence();
+
+    std::cout << "\nAll CDCL tests passed!\n";
+    return 0;
+}
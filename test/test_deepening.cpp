@@ -0,0 +1,120 @@
+#include <iostream>
+#include <cassert>
+#include "../src/variable_pattern.hpp"
+#include "../src/known_pattern.cpp"
+#include "../src/deepening.hpp"
+#include "../src/solution.hpp"
+#include "../src/cdcl.hpp"
+
+// The smallest depth at which something moves by (1, 1) is 4: the glider
+void test_glider_depth() {
+    Bounds box({0, 6}, {0, 6}, {0, 6});
+    VariablePattern pattern(box);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(box);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.set_deduplicate(false);
+    problem.build();
+
+    CdclSolver solver;
+    solver.add_clause(generation_alive_clause(problem, 0));
+    DeepeningResult found = iterative_deepening(problem, solver, [](const SearchProblem& p, int depth) {
+        return shifted_copy_constraints(p, depth, 1, 1);
+    });
+    assert(found.status == SolverStatus::SAT);
+    assert(found.depth == 4);
+    assert(solver.stats().solves == 4);
+
+    BitPlane gen0 = extract_generation(problem, found.solution, 0);
+    BitPlane gen4 = extract_generation(problem, found.solution, 4);
+    assert(!gen0.trimmed().words.empty());
+    BitPlane evolved = gen0;
+    for (int t = 0; t < 4; t++) evolved = life_step(evolved);
+    for (int y = 0; y <= 6; y++)
+        for (int x = 0; x <= 6; x++) {
+            assert(evolved.get(x, y) == gen4.get(x, y));
+            assert(gen4.get(x, y) == gen0.get(x - 1, y - 1));
+        }
+    std::cout << "PASSED: test_glider_depth (" << solver.stats().conflicts << " conflicts)\n";
+}
+
+// A 3x3 box with a dead border only has its center cell, and a lone cell cannot stay alive:
+// forcing it alive in generations 0 and 1 is refuted without the end constraints, so the driver
+// stops after the first depth
+void test_stops_before_end_constraints() {
+    Bounds box({0, 2}, {0, 2}, {0, 4});
+    VariablePattern pattern(box);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(box);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.set_deduplicate(false);
+    problem.build();
+
+    CdclSolver solver;
+    solver.add_clause({problem.get_cell_value({1, 1, 0}) - 1});
+    solver.add_clause({problem.get_cell_value({1, 1, 1}) - 1});
+    DeepeningResult found = iterative_deepening(problem, solver, [](const SearchProblem& p, int depth) {
+        return shifted_copy_constraints(p, depth, 0, 0);
+    });
+    assert(found.status == SolverStatus::UNSAT);
+    assert(found.depth == 1);
+    std::cout << "PASSED: test_stops_before_end_constraints\n";
+}
+
+void test_min_depth_and_dedup_check() {
+    Bounds box({0, 5}, {0, 5}, {0, 3});
+    VariablePattern pattern(box);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(box);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.build();
+
+    CdclSolver solver;
+    bool refused = false;
+    try {
+        iterative_deepening(problem, solver, [](const SearchProblem& p, int depth) {
+            return shifted_copy_constraints(p, depth, 0, 0);
+        });
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    assert(refused);
+
+    problem.set_deduplicate(false);
+    problem.build();
+    // a block or blinker fits; an oscillator of period dividing 2 is found at depth 2 first
+    solver.add_clause(generation_alive_clause(problem, 0));
+    DeepeningResult found = iterative_deepening(problem, solver, [](const SearchProblem& p, int depth) {
+        return shifted_copy_constraints(p, depth, 0, 0);
+    }, 2);
+    assert(found.status == SolverStatus::SAT && found.depth == 2);
+    assert(solver.stats().solves == 1);
+    std::cout << "PASSED: test_min_depth_and_dedup_check\n";
+}
+
+void test_equal_cells() {
+    BigClauseList clauses;
+    add_equal_cells(clauses, 0, 0);
+    add_equal_cells(clauses, 5, 5);
+    assert(clauses.empty());
+    add_equal_cells(clauses, 0, 1);
+    assert(clauses.size() == 1 && clauses[0].empty());
+    clauses.clear();
+    add_equal_cells(clauses, 1, 5);
+    add_equal_cells(clauses, 6, 0);
+    assert((clauses == BigClauseList{{4}, {-5}}));
+    clauses.clear();
+    add_equal_cells(clauses, 3, 4);
+    assert((clauses == BigClauseList{{-2, 3}, {2, -3}}));
+    std::cout << "PASSED: test_equal_cells\n";
+}
+
+int main() {
+    test_equal_cells();
+    test_glider_depth();
+    test_stops_before_end_constraints();
+    test_min_depth_and_dedup_check();
+
+    std::cout << "\nAll deepening tests passed!\n";
+    return 0;
+}
@@ -42,7 +42,7 @@ VariablePattern create_diagonal_wire_pattern() {
     });
 
     // Boundary cells don't follow rules (but still part of wire group)
-    for (auto& cell : const_cast<std::vector<Cell>&>(pattern.get_cells())) {
+    for (auto& cell : const_cast<CellList&>(pattern.get_cells())) {
         if (pattern.is_boundary(cell.position)) {
             cell.follows_rules = false;
         }
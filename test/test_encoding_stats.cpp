@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cassert>
+#include "../src/search_problem.hpp"
+#include "../src/variable_pattern.hpp"
+#include "../src/encoding_stats.hpp"
+
+void test_clause_list_stats() {
+    ClauseList clauses = {make_clause({1, -2}), make_clause({2})};
+    EncodingStats stats = clause_list_stats(clauses, 3, {{1, 2, 3}});
+    assert(stats.num_clauses == 3);
+    assert((stats.clause_lengths == std::map<int, size_t>{{1, 1}, {2, 1}, {3, 1}}));
+    assert((stats.positive_occurrences == std::vector<size_t>{2, 2, 1}));
+    assert((stats.negative_occurrences == std::vector<size_t>{0, 1, 0}));
+    auto histogram = stats.occurrence_histogram();
+    assert(histogram.size() == 3);
+    assert(histogram[1] == std::make_pair(std::string("1"), size_t(1)));
+    assert(histogram[2] == std::make_pair(std::string("2-3"), size_t(2)));
+    std::cout << "PASSED: test_clause_list_stats\n";
+}
+
+// 6x6 box over 3 generations. Entry 0 (x < 3) is unknown, with a stable cell group inside and
+// unconstrained boundary cells; entry 1 (x >= 3) is known dead.
+void test_search_problem_stats() {
+    Bounds box({0, 5}, {0, 5}, {0, 2});
+    VariablePattern left(box);
+    int stable = left.add_cell_group({1, 0, 0, 1, 0, 0, 1});
+    left.set_cell_group_if(stable, [&](const Cell& c) { return !left.is_boundary(c.position); });
+    for (auto& cell : const_cast<CellList&>(left.get_cells()))
+        if (left.is_boundary(cell.position)) cell.follows_rules = false;
+    VariablePattern right(box);
+    right.set_known_if(false, [](const Cell&) { return true; });
+
+    SearchProblem problem(box);
+    problem.add_entry(&left, [](Point p) { return std::get<0>(p) < 3; });
+    problem.add_entry(&right, [](Point p) { return std::get<0>(p) >= 3; });
+    problem.build();
+
+    ClauseList clauses = problem.get_clauses();
+    EncodingStats stats = problem.encoding_stats();
+    assert(stats.num_variables == problem.num_variables());
+    assert(stats.num_clauses == clauses.size());
+
+    size_t by_length = 0, by_generation = 0, occurrences = 0, literals = 0;
+    for (const auto& [len, n] : stats.clause_lengths) by_length += len * n;
+    for (const auto& [t, n] : stats.clauses_per_generation) by_generation += n;
+    for (int v = 0; v < stats.num_variables; v++) occurrences += stats.positive_occurrences[v] + stats.negative_occurrences[v];
+    for (const Clause& c : clauses)
+        for (int lit : c) literals += lit != 0;
+    assert(by_generation == clauses.size());
+    assert(by_length == literals && occurrences == literals);
+    assert((stats.clauses_per_generation.size() == 2 && stats.clauses_per_generation.count(1)));
+
+    // left boundary outputs: x = 0 column and the top / bottom cells at x = 1, 2
+    assert(stats.unconstrained == 2 * 10);
+    assert(stats.transitions == 2 * 36 - stats.unconstrained);
+    // outputs at x = 4, 5 see only dead cells
+    assert(stats.fully_known == 2 * 12);
+    assert(stats.distinct_signatures > 0 && stats.distinct_signatures <= stats.transitions - stats.fully_known);
+
+    size_t by_origin = 0;
+    for (const auto& [origin, n] : stats.variables_by_origin) {
+        assert(origin.rfind("entry 1", 0) != 0);  // the known entry has no variables
+        by_origin += n;
+    }
+    assert(by_origin == size_t(stats.num_variables));
+    assert(stats.variables_by_origin.count("entry 0 / group 0"));
+
+    std::string report = stats.report();
+    assert(report.find("Clause lengths:") != std::string::npos);
+    assert(report.find("distinct signatures") != std::string::npos);
+    assert(report.find("entry 0 / group 0") != std::string::npos);
+    std::cout << "PASSED: test_search_problem_stats\n";
+}
+
+int main() {
+    test_clause_list_stats();
+    test_search_problem_stats();
+
+    std::cout << "\nAll encoding stats tests passed!\n";
+    return 0;
+}
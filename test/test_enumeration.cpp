@@ -0,0 +1,168 @@
+#include <iostream>
+#include <sstream>
+#include <cassert>
+#include <random>
+#include "../src/variable_pattern.hpp"
+#include "../src/known_pattern.cpp"
+#include "../src/enumeration.hpp"
+#include "../src/deepening.hpp"
+#include "../src/cdcl.hpp"
+
+using Formula = std::vector<std::vector<int>>;
+
+bool satisfies(const Formula& formula, uint32_t bits) {
+    for (const auto& clause : formula) {
+        bool sat = false;
+        for (int lit : clause) sat |= (((bits >> (std::abs(lit) - 1)) & 1) != 0) == (lit > 0);
+        if (!sat) return false;
+    }
+    return true;
+}
+
+// Projections (bits of variables 1..k) of all models over n variables
+std::set<uint32_t> brute_force_projections(const Formula& formula, int n, int k) {
+    std::set<uint32_t> projections;
+    for (uint32_t bits = 0; bits < (1u << n); bits++)
+        if (satisfies(formula, bits)) projections.insert(bits & ((1u << k) - 1));
+    return projections;
+}
+
+// Projections a (possibly minimized) solution stands for: every setting of the missing variables
+void expand(const std::vector<int>& literals, int k, std::set<uint32_t>& out) {
+    uint32_t fixed = 0, values = 0;
+    for (int lit : literals) {
+        fixed |= 1u << (std::abs(lit) - 1);
+        if (lit > 0) values |= 1u << (lit - 1);
+    }
+    for (uint32_t bits = 0; bits < (1u << k); bits++)
+        if ((bits & fixed) == values) out.insert(bits);
+}
+
+void test_random_projections() {
+    std::mt19937 rng(3);
+    const int n = 10, k = 4;
+    std::vector<int> projection = {1, 2, 3, 4};
+    size_t total_dropped = 0;
+    for (int round = 0; round < 40; round++) {
+        Formula formula;
+        std::uniform_int_distribution<int> var(1, n), sign(0, 1);
+        for (int i = 0; i < 25; i++) {
+            std::vector<int> clause;
+            for (int j = 0; j < 3; j++) clause.push_back(sign(rng) ? var(rng) : -var(rng));
+            formula.push_back(clause);
+        }
+        std::set<uint32_t> expected = brute_force_projections(formula, n, k);
+
+        CdclSolver plain;
+        for (const auto& clause : formula) plain.add_clause(clause);
+        std::set<uint32_t> seen;
+        EnumerationResult result = enumerate_projected(plain, projection, n, [&](const ProjectedSolution& s) {
+            assert(s.literals.size() == projection.size());
+            size_t before = seen.size();
+            expand(s.literals, k, seen);
+            assert(seen.size() == before + 1);  // never the same projection twice
+            return true;
+        });
+        assert(result.status == SolverStatus::UNSAT);
+        assert(seen == expected && result.solutions == expected.size());
+        // blocking clauses are retired: the solver is as before
+        assert(plain.solve() == (expected.empty() ? SolverStatus::UNSAT : SolverStatus::SAT));
+
+        SupportMinimizer minimizer;
+        minimizer.add_clauses(BigClauseList(formula.begin(), formula.end()));
+        CdclSolver lifted;
+        for (const auto& clause : formula) lifted.add_clause(clause);
+        EnumerationOptions options;
+        options.minimizer = &minimizer;
+        std::set<uint32_t> covered;
+        result = enumerate_projected(lifted, projection, n, [&](const ProjectedSolution& s) {
+            std::set<uint32_t> cube;
+            expand(s.literals, k, cube);
+            for (uint32_t bits : cube) assert(expected.count(bits));  // don't-cares really are
+            covered.insert(cube.begin(), cube.end());
+            return true;
+        }, options);
+        assert(covered == expected && result.solutions <= expected.size());
+        total_dropped += result.dont_cares;
+    }
+    assert(total_dropped > 0);
+    std::cout << "PASSED: test_random_projections (" << total_dropped << " don't-cares dropped)\n";
+}
+
+// Still lifes in a 4x4 area, projected on generation 0, against an exhaustive scan
+void test_still_lifes() {
+    Bounds bounds({0, 5}, {0, 5}, {0, 1});
+    VariablePattern pattern(bounds);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(bounds);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.build();
+
+    CdclSolver solver;
+    solver.add_clauses(problem.get_clauses());
+    solver.add_clauses(shifted_copy_constraints(problem, 1, 0, 0));
+    solver.add_clause(generation_alive_clause(problem, 0));
+    std::vector<int> projection = generation_variables(problem, 0);
+    assert(projection.size() == 16);
+
+    std::set<std::string> found;
+    std::ostringstream stream;
+    ProjectedCallback write = write_generation_stream(problem, 0, stream);
+    EnumerationResult result = enumerate_projected(solver, projection, problem.num_variables(),
+                                                   [&](const ProjectedSolution& s) {
+        BitPlane gen0 = extract_generation(problem, s.model, 0);
+        assert(life_step(gen0).trimmed().words == gen0.trimmed().words);
+        std::string cells;
+        for (int y = 1; y <= 4; y++)
+            for (int x = 1; x <= 4; x++) cells += gen0.get(x, y) ? 'o' : '.';
+        found.insert(cells);
+        return write(s);
+    });
+
+    int expected = 0;
+    for (uint32_t bits = 1; bits < (1u << 16); bits++) {
+        BitPlane plane(0, 0, 6, 6);
+        for (int i = 0; i < 16; i++) plane.set(1 + i % 4, 1 + i / 4, (bits >> i) & 1);
+        BitPlane next = life_step(plane);
+        bool still = true;
+        for (int y = -1; y <= 6 && still; y++)
+            for (int x = -1; x <= 6 && still; x++) still = next.get(x, y) == plane.get(x, y);
+        expected += still;
+    }
+    assert(result.status == SolverStatus::UNSAT);
+    assert(int(result.solutions) == expected && int(found.size()) == expected);
+    assert(stream.str().find("#C solution " + std::to_string(expected) + "\n") != std::string::npos);
+    std::cout << "PASSED: test_still_lifes (" << expected << " still lifes)\n";
+}
+
+void test_limit_and_stop() {
+    CdclSolver solver;
+    solver.add_clause({1, 2, 3});
+    EnumerationOptions options;
+    options.limit = 3;
+    size_t calls = 0;
+    EnumerationResult result = enumerate_projected(solver, {1, 2, 3}, 3, [&](const ProjectedSolution&) {
+        calls++;
+        return true;
+    }, options);
+    assert(result.status == SolverStatus::SAT && result.solutions == 3 && calls == 3);
+
+    result = enumerate_projected(solver, {1, 2, 3}, 3, [&](const ProjectedSolution& s) { return s.index < 1; });
+    assert(result.status == SolverStatus::SAT && result.solutions == 2);
+
+    // projections under assumptions
+    options = EnumerationOptions();
+    options.assumptions = {-1, -2};
+    result = enumerate_projected(solver, {1, 2, 3}, 3, [](const ProjectedSolution&) { return true; }, options);
+    assert(result.status == SolverStatus::UNSAT && result.solutions == 1);
+    std::cout << "PASSED: test_limit_and_stop\n";
+}
+
+int main() {
+    test_random_projections();
+    test_still_lifes();
+    test_limit_and_stop();
+
+    std::cout << "\nAll enumeration tests passed!\n";
+    return 0;
+}
@@ -1,5 +1,14 @@
 #include <cassert>
 #include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
 #include "../src/known_pattern.cpp"
 
 // Helper to check if a set of points matches the expected on-cells at a given generation
@@ -136,11 +145,180 @@ void test_glider_evolution() {
     std::cout << "PASSED: test_glider_evolution\n";
 }
 
+// Reference B3/S23 step over a set of live cells
+std::set<std::pair<int,int>> naive_step(const std::set<std::pair<int,int>>& live) {
+    std::map<std::pair<int,int>, int> counts;
+    for (auto [x, y] : live)
+        for (int dy = -1; dy <= 1; dy++)
+            for (int dx = -1; dx <= 1; dx++)
+                if (dx != 0 || dy != 0) counts[{x + dx, y + dy}]++;
+    std::set<std::pair<int,int>> next;
+    for (auto [p, n] : counts)
+        if (n == 3 || (n == 2 && live.count(p))) next.insert(p);
+    return next;
+}
+
+// Bitboard evolution must match the reference on a soup wider than one 64-bit word
+void test_bitboard_matches_reference() {
+    std::mt19937 rng(12345);
+    int width = 150, height = 40;
+    std::string rle;
+    std::set<std::pair<int,int>> live;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            bool alive = rng() % 3 == 0;
+            rle += alive ? 'o' : 'b';
+            if (alive) live.insert({x, y});
+        }
+        rle += '$';
+    }
+    rle += '!';
+
+    int max_gen = 60;
+    KnownPattern pattern(rle, max_gen);
+    for (int gen = 0; gen <= max_gen; gen++) {
+        auto [xlims, ylims, tlims] = pattern.bounds;
+        for (int y = ylims.first - 1; y <= ylims.second + 1; y++)
+            for (int x = xlims.first - 1; x <= xlims.second + 1; x++)
+                assert(pattern.get_state({x, y, gen}) == (live.count({x, y}) > 0));
+        live = naive_step(live);
+    }
+
+    std::cout << "PASSED: test_bitboard_matches_reference\n";
+}
+
+// Constructing from a set of generation-0 cells evolves the same as from RLE
+void test_on_cells_constructor() {
+    std::set<Point> glider = {{1, 0, 0}, {2, 1, 0}, {0, 2, 0}, {1, 2, 0}, {2, 2, 0}};
+    KnownPattern from_cells(glider, 8);
+    KnownPattern from_rle("bo$2bo$3o!", 8);
+    for (int gen = 0; gen <= 8; gen++)
+        for (int y = -1; y <= 6; y++)
+            for (int x = -1; x <= 6; x++)
+                assert(from_cells.get_state({x, y, gen}) == from_rle.get_state({x, y, gen}));
+
+    // Row extraction, with the shift applied
+    from_rle.shift_by({10, 20, 0});
+    BitPlane row = from_rle.get_generation(4, {10, 14}, {23, 23});
+    assert(row.width == 5 && row.height == 1);
+    assert(!row.get(10, 23) && row.get(11, 23) && row.get(12, 23) && row.get(13, 23) && !row.get(14, 23));
+
+    std::cout << "PASSED: test_on_cells_constructor\n";
+}
+
+// A default pattern filled in field by field, as before the evolution backends
+void test_hand_filled_pattern() {
+    KnownPattern pattern;
+    pattern.on_cells.insert({1, 0, 0});
+    pattern.on_cells.insert({1, 1, 1});
+    pattern.bounds = {{0, 2}, {0, 2}, {0, 1}};
+    pattern.shift_by({3, 0, 0});
+    assert(pattern.get_state({4, 0, 0}) && pattern.get_state({4, 1, 1}));
+    assert(!pattern.get_state({1, 0, 0}) && !pattern.get_state({4, 1, 0}));
+    BitPlane gen1 = pattern.get_generation(1);
+    assert(gen1.population() == 1 && gen1.get(4, 1));
+    std::cout << "PASSED: test_hand_filled_pattern\n";
+}
+
+// Patterns evolved from the same generation 0 and max_gen share one history
+void test_shared_history() {
+    size_t before = shared_history_count();
+    {
+        KnownPattern a("3o!", 10);
+        KnownPattern b("x = 3, y = 1, rule = B3/S23\n3o!", 10);
+        KnownPattern c("3o!", 12);
+        b.shift_by({5, 5, 0});
+        assert(a.get_history() == b.get_history());
+        assert(a.get_history() != c.get_history());
+        assert(shared_history_count() == before + 2);
+        // each view applies its own shift to the shared storage
+        assert(a.get_state({1, -1, 1}) && a.get_state({1, 1, 1}));
+        assert(b.get_state({6, 4, 1}) && b.get_state({6, 6, 1}));
+        assert(!b.get_state({1, 1, 1}));
+
+        KnownPattern copy = a;
+        assert(copy.get_history() == a.get_history());
+    }
+    // the registry does not keep histories alive on its own
+    assert(shared_history_count() == before);
+
+    // threads asking at once get one history per key, built once
+    {
+        BitPlane gen0s[2] = {parse_rle("3o!"), parse_rle("bo$2bo$3o!")};
+        std::vector<std::shared_ptr<const EvolvedHistory>> seen(8);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; i++)
+            threads.emplace_back([&, i]() { seen[i] = shared_history(gen0s[i % 2], 200); });
+        for (std::thread& thread : threads) thread.join();
+        for (int i = 2; i < 8; i++) assert(seen[i] == seen[i % 2]);
+        assert(seen[0] != seen[1]);
+        assert(shared_history_count() == before + 2);
+    }
+    assert(shared_history_count() == before);
+    std::cout << "PASSED: test_shared_history\n";
+}
+
+// Name of the first regular entry in a directory
+std::string readdir_first(const char* path) {
+    DIR* d = opendir(path);
+    std::string name;
+    while (dirent* entry = readdir(d)) {
+        if (entry->d_name[0] != '.') {
+            name = entry->d_name;
+            break;
+        }
+    }
+    closedir(d);
+    return name;
+}
+
+// Histories written to the disk cache are memory-mapped back instead of re-evolved
+void test_disk_cache() {
+    char dir[] = "/tmp/test_history_cache_XXXXXX";
+    assert(mkdtemp(dir));
+    set_history_cache_dir(dir);
+    std::string rle = "x = 3, y = 3, rule = B3/S23\nbo$2bo$3o!";
+    int max_gen = 40;
+
+    std::vector<BitPlane> expected;
+    {
+        KnownPattern evolved(rle, max_gen);
+        assert(!evolved.get_history()->is_mapped());
+        for (int gen = 0; gen <= max_gen; gen++) expected.push_back(evolved.get_generation(gen));
+    }
+    {
+        KnownPattern cached(rle, max_gen);
+        assert(cached.get_history()->is_mapped());
+        assert(cached.get_bounds() == KnownPattern(parse_rle(rle), max_gen).get_bounds());
+        for (int gen = 0; gen <= max_gen; gen++) assert(cached.get_generation(gen) == expected[gen]);
+    }
+
+    // A damaged file is ignored and replaced
+    std::string file = std::string(dir) + "/" + readdir_first(dir);
+    truncate(file.c_str(), 100);
+    {
+        KnownPattern evolved(rle, max_gen);
+        assert(!evolved.get_history()->is_mapped());
+        assert(evolved.get_generation(max_gen) == expected[max_gen]);
+    }
+    assert(KnownPattern(rle, max_gen).get_history()->is_mapped());
+
+    std::remove(file.c_str());
+    rmdir(dir);
+    set_history_cache_dir("");
+    std::cout << "PASSED: test_disk_cache\n";
+}
+
 int main() {
     test_shift();
     test_blinker_oscillation();
     test_honeyfarm_evolution();
     test_glider_evolution();
+    test_bitboard_matches_reference();
+    test_on_cells_constructor();
+    test_hand_filled_pattern();
+    test_shared_history();
+    test_disk_cache();
 
     std::cout << "\nAll evolution tests passed!\n";
     return 0;
@@ -0,0 +1,67 @@
+#include <cassert>
+#include <iostream>
+#include "../src/known_pattern.cpp"
+
+const std::string GOSPER_GUN = R"(x = 36, y = 9, rule = B3/S23
+24bo$22bobo$12b2o6b2o12b2o$11bo3bo4b2o12b2o$2o8bo5bo3b2o$2o8bo3bob2o4b
+obo$10bo5bo7bo$11bo3bo$12b2o!)";
+
+// Every cell in the union of both patterns' bounds must agree at the given generations
+void assert_backends_match(const KnownPattern& a, const KnownPattern& b, std::vector<int> gens) {
+    auto [xlims, ylims, tlims] = a.get_bounds();
+    for (int gen : gens)
+        for (int y = ylims.first - 1; y <= ylims.second + 1; y++)
+            for (int x = xlims.first - 1; x <= xlims.second + 1; x++)
+                assert(a.get_state({x, y, gen}) == b.get_state({x, y, gen}));
+}
+
+void test_gun_matches_bitboard() {
+    int max_gen = 300;
+    KnownPattern bitboard(GOSPER_GUN, max_gen);
+    KnownPattern hashlife(GOSPER_GUN, max_gen, EvolutionBackend::HASHLIFE);
+    assert_backends_match(bitboard, hashlife, {0, 1, 2, 29, 30, 31, 64, 127, 255, 299, 300});
+    std::cout << "PASSED: test_gun_matches_bitboard\n";
+}
+
+// A glider far in the future: moves (1, 1) every 4 generations
+void test_glider_far_ahead() {
+    int max_gen = 40000;
+    KnownPattern glider("bo$2bo$3o!", max_gen, EvolutionBackend::HASHLIFE);
+    int d = max_gen / 4;
+    assert(glider.get_state({1 + d, 0 + d, max_gen}));
+    assert(glider.get_state({2 + d, 1 + d, max_gen}));
+    assert(glider.get_state({0 + d, 2 + d, max_gen}));
+    assert(glider.get_state({1 + d, 2 + d, max_gen}));
+    assert(glider.get_state({2 + d, 2 + d, max_gen}));
+    assert(!glider.get_state({1 + d, 1 + d, max_gen}));
+    assert(!glider.get_state({1, 0, max_gen}));
+    std::cout << "PASSED: test_glider_far_ahead\n";
+}
+
+// Restricting queries to a small window still answers queries outside it correctly
+void test_query_window() {
+    int max_gen = 1000;
+    KnownPattern bitboard(GOSPER_GUN, max_gen);
+    KnownPattern hashlife(GOSPER_GUN, max_gen, EvolutionBackend::HASHLIFE);
+    hashlife.shift_by({5, -3, 0});
+    hashlife.restrict_queries(Bounds({5, 40}, {-3, 6}, {990, 1000}));
+    for (int gen = 990; gen <= 1000; gen++)
+        for (int y = -3; y <= 6; y++)
+            for (int x = 5; x <= 40; x++)
+                assert(hashlife.get_state({x, y, gen}) == bitboard.get_state({x - 5, y + 3, gen}));
+    // gliders leave the window heading south-east
+    for (int k = 0; k < 40; k++) {
+        Point p = {40 + k, 10 + k, 1000};
+        assert(hashlife.get_state(p) == bitboard.get_state(p - Point(5, -3, 0)));
+    }
+    std::cout << "PASSED: test_query_window\n";
+}
+
+int main() {
+    test_gun_matches_bitboard();
+    test_glider_far_ahead();
+    test_query_window();
+
+    std::cout << "\nAll hashlife tests passed!\n";
+    return 0;
+}
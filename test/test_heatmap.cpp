@@ -0,0 +1,99 @@
+#include <iostream>
+#include <fstream>
+#include <cassert>
+#include <cstdio>
+#include "../src/search_problem.hpp"
+#include "../src/variable_pattern.hpp"
+#include "../src/heatmap.hpp"
+
+// 6x6 box over 3 generations, as in test_encoding_stats: entry 0 (x < 3) is unknown with a
+// stable cell group inside and unconstrained boundary cells; entry 1 (x >= 3) is known dead.
+void test_search_problem_heatmap() {
+    Bounds box({0, 5}, {0, 5}, {0, 2});
+    VariablePattern left(box);
+    int stable = left.add_cell_group({1, 0, 0, 1, 0, 0, 1});
+    left.set_cell_group_if(stable, [&](const Cell& c) { return !left.is_boundary(c.position); });
+    for (auto& cell : const_cast<CellList&>(left.get_cells()))
+        if (left.is_boundary(cell.position)) cell.follows_rules = false;
+    VariablePattern right(box);
+    right.set_known_if(false, [](const Cell&) { return true; });
+
+    SearchProblem problem(box);
+    problem.add_entry(&left, [](Point p) { return std::get<0>(p) < 3; });
+    problem.add_entry(&right, [](Point p) { return std::get<0>(p) >= 3; });
+    problem.build();
+
+    ClauseList clauses = problem.get_clauses();
+    EncodingStats stats = problem.encoding_stats();
+    TransitionHeatmap heatmap = problem.transition_heatmap();
+    assert(heatmap.total_clauses() == clauses.size());
+
+    std::vector<size_t> per_generation = heatmap.clauses_per_generation();
+    assert(per_generation.size() == 3 && per_generation[0] == 0);
+    assert(per_generation[1] == stats.clauses_per_generation[1]);
+    assert(per_generation[2] == stats.clauses_per_generation[2]);
+
+    size_t counts[4] = {0, 0, 0, 0};
+    for (int t = 0; t <= 2; t++) {
+        for (int y = 0; y <= 5; y++) {
+            for (int x = 0; x <= 5; x++) {
+                const HeatmapCell& cell = heatmap.at({x, y, t});
+                counts[int(cell.status)]++;
+                assert(cell.entry == (x < 3 ? 0 : 1));
+                assert(cell.variable == problem.get_cell_value({x, y, t}));
+                assert(cell.raw_variable == problem.get_raw_cell_value({x, y, t}));
+                if (cell.status == TransitionStatus::UNCONSTRAINED || cell.status == TransitionStatus::KNOWN)
+                    assert(cell.clauses == 0);
+            }
+        }
+    }
+    // the first generation has no transition
+    assert(counts[int(TransitionStatus::UNCONSTRAINED)] == 36 + stats.unconstrained);
+    assert(counts[int(TransitionStatus::KNOWN)] == stats.fully_known);
+    assert(counts[int(TransitionStatus::ENCODED)] == stats.distinct_signatures);
+    assert(counts[int(TransitionStatus::DUPLICATE)] ==
+           stats.transitions - stats.fully_known - stats.distinct_signatures);
+    // the stable group repeats each generation-1 transition in generation 2
+    assert(counts[int(TransitionStatus::DUPLICATE)] > 0);
+    std::cout << "PASSED: test_search_problem_heatmap\n";
+}
+
+void test_write_heatmap_csv() {
+    Bounds box({-1, 1}, {0, 1}, {0, 1});
+    TransitionHeatmap heatmap(box);
+    heatmap.at({0, 0, 1}).entry = 2;
+    std::array<int, 10> ten_cells = {0, 0, 0, 0, 5, 0, 0, 0, 0, 5};
+    heatmap.record_transition({0, 0, 1}, ten_cells, 3);
+    heatmap.record_transition({1, 0, 1}, {0, 0, 0, 0, 1, 0, 0, 0, 0, 0}, 0);
+
+    const std::string filename = "test_heatmap_output.csv";
+    write_heatmap_csv(heatmap, filename, true);
+    bool refused = false;
+    try {
+        write_heatmap_csv(heatmap, filename);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    assert(refused);
+
+    std::ifstream file(filename);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(file, line)) lines.push_back(line);
+    std::remove(filename.c_str());
+
+    assert(lines.size() == 1 + 3 * 2 * 2);
+    assert(lines[0] == "x,y,t,entry,variable,raw_variable,status,clauses");
+    assert(lines[1] == "-1,0,0,-1,0,0,unconstrained,0");
+    assert(lines[8] == "0,0,1,2,0,0,encoded,3");
+    assert(lines[9] == "1,0,1,-1,0,0,known,0");
+    std::cout << "PASSED: test_write_heatmap_csv\n";
+}
+
+int main() {
+    test_search_problem_heatmap();
+    test_write_heatmap_csv();
+
+    std::cout << "\nAll heatmap tests passed!\n";
+    return 0;
+}
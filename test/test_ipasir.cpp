@@ -0,0 +1,91 @@
+#define HAVE_IPASIR
+#include <iostream>
+#include <cassert>
+#include "../src/variable_pattern.hpp"
+#include "../src/known_pattern.cpp"
+#include "../src/deepening.hpp"
+#include "../src/solution.hpp"
+#include "../src/cdcl.hpp"
+
+// A stub IPASIR library over CdclSolver, so that IpasirSolver is built and run without an
+// external solver. Assumptions are collected until the next ipasir_solve, as IPASIR specifies.
+struct StubIpasir {
+    CdclSolver solver;
+    std::vector<int> clause;
+    std::vector<int> assumptions;
+};
+
+extern "C" {
+const char* ipasir_signature() { return "stub-cdcl"; }
+void* ipasir_init() { return new StubIpasir(); }
+void ipasir_release(void* solver) { delete static_cast<StubIpasir*>(solver); }
+void ipasir_add(void* solver, int32_t lit_or_zero) {
+    StubIpasir& s = *static_cast<StubIpasir*>(solver);
+    if (lit_or_zero != 0) {
+        s.clause.push_back(lit_or_zero);
+        return;
+    }
+    s.solver.add_clause(s.clause);
+    s.clause.clear();
+}
+void ipasir_assume(void* solver, int32_t lit) { static_cast<StubIpasir*>(solver)->assumptions.push_back(lit); }
+int ipasir_solve(void* solver) {
+    StubIpasir& s = *static_cast<StubIpasir*>(solver);
+    SolverStatus status = s.solver.solve(s.assumptions);
+    s.assumptions.clear();
+    return status == SolverStatus::SAT ? 10 : status == SolverStatus::UNSAT ? 20 : 0;
+}
+int32_t ipasir_val(void* solver, int32_t lit) { return static_cast<StubIpasir*>(solver)->solver.value(lit) ? lit : -lit; }
+int ipasir_failed(void* solver, int32_t lit) { return static_cast<StubIpasir*>(solver)->solver.failed(lit); }
+}
+
+void test_adapter() {
+    assert(std::string(IpasirSolver::signature()) == "stub-cdcl");
+    IpasirSolver solver;
+    solver.add_clause({1, 2});
+    solver.add_clause({-1, 3});
+    assert(solver.num_variables() == 3);
+    assert(solver.solve({1}) == SolverStatus::SAT);
+    assert(solver.value(1) && solver.value(3) && !solver.value(-3));
+
+    int act = solver.new_variable();
+    assert(act == 4);
+    solver.add_clause({-act, -3});
+    assert(solver.solve({act, 1}) == SolverStatus::UNSAT);
+    assert(solver.failed(act) && solver.failed(1));
+    // assumptions only hold for one solve
+    assert(solver.solve() == SolverStatus::SAT);
+    std::cout << "PASSED: test_adapter\n";
+}
+
+// The deepening driver through the adapter finds the glider at depth 4, as with CdclSolver
+void test_deepening_through_adapter() {
+    Bounds box({0, 6}, {0, 6}, {0, 6});
+    VariablePattern pattern(box);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(box);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.set_deduplicate(false);
+    problem.build();
+
+    IpasirSolver solver;
+    solver.add_clause(generation_alive_clause(problem, 0));
+    DeepeningResult found = iterative_deepening(problem, solver, [](const SearchProblem& p, int depth) {
+        return shifted_copy_constraints(p, depth, 1, 1);
+    });
+    assert(found.status == SolverStatus::SAT && found.depth == 4);
+
+    BitPlane gen0 = extract_generation(problem, found.solution, 0);
+    BitPlane gen4 = extract_generation(problem, found.solution, 4);
+    for (int y = 0; y <= 6; y++)
+        for (int x = 0; x <= 6; x++) assert(gen4.get(x, y) == gen0.get(x - 1, y - 1));
+    std::cout << "PASSED: test_deepening_through_adapter\n";
+}
+
+int main() {
+    test_adapter();
+    test_deepening_through_adapter();
+
+    std::cout << "\nAll IPASIR adapter tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../src/variable_grid.cpp"
+#include "../src/logging.hpp"
+
+VariablePattern small_pattern() {
+    VariablePattern pattern(4, 4, 1);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    return pattern;
+}
+
+std::string read_file(const std::string& filename) {
+    std::ifstream file(filename);
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+void test_callback_and_levels() {
+    std::vector<std::pair<logging::Level, std::string>> messages;
+    logging::set_sink(std::make_shared<logging::CallbackSink>(
+        [&](logging::Level level, const std::string& message) { messages.push_back({level, message}); }));
+
+    VariableGrid var_grid = construct_variable_grid(small_pattern());
+    int num_variables;
+    calculate_clauses(var_grid, num_variables);
+    assert(messages.size() == 2);
+    assert(messages[0].first == logging::Level::INFO);
+    assert(messages[0].second.rfind("  construct_variable_grid: ", 0) == 0);
+    assert(messages[1].second.rfind("  calculate_clauses: ", 0) == 0);
+    assert(messages[1].second.back() != '\n');
+
+    messages.clear();
+    logging::set_level(logging::Level::WARNING);
+    assert(!logging::enabled(logging::Level::INFO) && logging::enabled(logging::Level::ERROR));
+    construct_variable_grid(small_pattern());
+    logging::warning() << "kept " << 1;
+    logging::debug() << "dropped";
+    assert(messages.size() == 1 && messages[0].second == "kept 1");
+    assert(messages[0].first == logging::Level::WARNING);
+
+    logging::set_level(logging::Level::OFF);
+    logging::error() << "dropped";
+    assert(messages.size() == 1);
+    logging::set_level(logging::Level::INFO);
+    std::cout << "PASSED: test_callback_and_levels\n";
+}
+
+void test_null_sink() {
+    logging::set_sink(std::make_shared<logging::NullSink>());
+    assert(!logging::enabled(logging::Level::ERROR));
+    construct_variable_grid(small_pattern());
+    logging::set_sink(nullptr);  // back to stdout
+    assert(logging::enabled(logging::Level::INFO));
+    std::cout << "PASSED: test_null_sink\n";
+}
+
+void test_buffered_file_sink() {
+    std::string filename = "/tmp/test_logging_" + std::to_string(getpid()) + ".log";
+    {
+        auto sink = std::make_shared<logging::BufferedFileSink>(filename);
+        logging::set_sink(sink);
+        logging::info() << "first";
+        assert(read_file(filename).empty());  // still buffered
+        logging::flush();
+        assert(read_file(filename) == "first\n");
+        logging::info() << "second";
+        logging::set_sink(nullptr);
+    }  // last reference gone: the sink flushes on destruction
+    assert(read_file(filename) == "first\nsecond\n");
+
+    {
+        logging::set_sink(std::make_shared<logging::BufferedFileSink>(filename, true, 8));
+        logging::info() << "longer than eight bytes";
+        assert(read_file(filename) == "longer than eight bytes\n");  // buffer full: written at once
+        logging::set_sink(nullptr);
+    }
+    std::remove(filename.c_str());
+    std::cout << "PASSED: test_buffered_file_sink\n";
+}
+
+int main() {
+    test_callback_and_levels();
+    test_null_sink();
+    test_buffered_file_sink();
+
+    std::cout << "\nAll logging tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+#include "../src/known_pattern.cpp"
+#include "../src/macrocell.hpp"
+
+std::string write_temp_file(const std::string& contents) {
+    char filename[] = "/tmp/test_macrocell_XXXXXX";
+    int fd = mkstemp(filename);
+    close(fd);
+    std::ofstream file(filename);
+    file << contents;
+    return filename;
+}
+
+// A glider in the south-west quadrant of a 16x16 root centered on the origin
+void test_small_file() {
+    std::string filename = write_temp_file(
+        "[M2] (golly 4.2)\n"
+        "#R B3/S23\n"
+        ".*$..*$***$\n"
+        "4 0 0 1 0\n");
+    KnownPattern glider(load_macrocell(filename, 8));
+    std::remove(filename.c_str());
+
+    KnownPattern expected("bo$2bo$3o!", 8);
+    expected.shift_by({-8, 0, 0});
+    for (int gen = 0; gen <= 8; gen++)
+        for (int y = -2; y <= 12; y++)
+            for (int x = -10; x <= 4; x++)
+                assert(glider.get_state({x, y, gen}) == expected.get_state({x, y, gen}));
+    std::cout << "PASSED: test_small_file\n";
+}
+
+// Two gliders 2^21 cells apart: far too big to expand, but cheap to query in a window
+void test_huge_sparse_file() {
+    std::string contents = "[M2] (golly 4.2)\n#R B3/S23\n.*$..*$***$\n";
+    int node = 1;
+    for (int level = 4; level <= 21; level++) {
+        contents += std::to_string(level) + " " + std::to_string(node) + " 0 0 0\n";
+        node++;
+    }
+    contents += "22 " + std::to_string(node) + " 0 0 " + std::to_string(node) + "\n";
+    std::string filename = write_temp_file(contents);
+    KnownPattern pattern(load_macrocell(filename, 8));
+    std::remove(filename.c_str());
+
+    // the south-east glider starts at the origin
+    pattern.restrict_queries(Bounds({-4, 12}, {-4, 12}, {0, 8}));
+    KnownPattern expected("bo$2bo$3o!", 8);
+    for (int gen = 0; gen <= 8; gen++)
+        for (int y = -4; y <= 12; y++)
+            for (int x = -4; x <= 12; x++)
+                assert(pattern.get_state({x, y, gen}) == expected.get_state({x, y, gen}));
+
+    // the north-west glider is answered from the quadtree without growing the window
+    int far = -(1 << 21);
+    assert(pattern.get_state({far + 1, far, 0}));
+    assert(!pattern.get_state({far + 1, far, 4}));
+    assert(pattern.get_state({far + 2, far + 1, 4}));
+    assert(pattern.get_state({far + 3, far + 3, 4}));
+    std::cout << "PASSED: test_huge_sparse_file\n";
+}
+
+int main() {
+    test_small_file();
+    test_huge_sparse_file();
+
+    std::cout << "\nAll macrocell tests passed!\n";
+    return 0;
+}
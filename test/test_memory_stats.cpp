@@ -0,0 +1,93 @@
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include "../src/memory_stats.hpp"
+
+const size_t MB = 1024 * 1024;
+
+// Allocate and touch `bytes`, then free them again
+void touch(size_t bytes) {
+    std::vector<char> block(bytes);
+    std::memset(block.data(), 1, bytes);
+    volatile char sink = block[bytes / 2];
+    (void)sink;
+}
+
+void test_rss_readings() {
+    size_t current = memory_stats::current_rss_bytes();
+    size_t peak = memory_stats::peak_rss_bytes();
+    assert(current > 0);
+    assert(peak >= current);
+    assert(memory_stats::format_bytes(512 * 1024) == "512 KB");
+    assert(memory_stats::format_bytes(3 * MB / 2) == "1.5 MB");
+    std::cout << "PASSED: test_rss_readings\n";
+}
+
+void test_phase_peaks() {
+    memory_stats::clear_phase_results();
+    // off by default: nothing is sampled and the kernel peak is left alone
+    assert(!memory_stats::enabled());
+    size_t peak_before = memory_stats::peak_rss_bytes();
+    {
+        memory_stats::PhaseMemory ignored("ignored");
+        assert(ignored.describe().rfind("RSS ", 0) == 0);
+    }
+    assert(memory_stats::phase_results().empty());
+    assert(memory_stats::peak_rss_bytes() >= peak_before);
+
+    memory_stats::enable();
+    memory_stats::PhaseStats outer_stats, inner_stats, after_stats;
+    {
+        memory_stats::PhaseMemory outer("outer");
+        {
+            memory_stats::PhaseMemory inner("inner");
+            touch(64 * MB);
+            inner_stats = inner.stop();
+        }
+        outer_stats = outer.stop();
+    }
+    {
+        memory_stats::PhaseMemory after("after");
+        after_stats = after.stop();
+    }
+
+    // the inner peak is part of the outer phase, whether or not the kernel peak was reset
+    assert(inner_stats.peak_rss >= inner_stats.start_rss + 60 * MB);
+    assert(outer_stats.peak_rss >= inner_stats.peak_rss);
+    // a phase that allocates nothing does not inherit an earlier peak when the reset works
+    if (after_stats.exact) assert(after_stats.peak_rss < inner_stats.peak_rss);
+
+    auto results = memory_stats::phase_results();
+    assert(results.size() == 3);
+    assert(results.at("inner").peak_rss == inner_stats.peak_rss);
+    memory_stats::enable(false);
+    std::cout << "PASSED: test_phase_peaks" << (after_stats.exact ? "" : " (peak reset unavailable)") << "\n";
+}
+
+void test_counting_allocator() {
+    using Tag = memory_stats::AllocTag;
+    memory_stats::reset_allocation_counts();
+    const memory_stats::AllocCounters& c = memory_stats::alloc_counters(Tag::DIMACS);
+    int64_t live_before = c.live_bytes;
+    {
+        std::vector<int, memory_stats::CountingAllocator<int, Tag::DIMACS>> v;
+        v.reserve(1000);
+        assert(c.live_bytes == live_before + int64_t(1000 * sizeof(int)));
+        v.resize(5000);
+    }
+    assert(c.live_bytes == live_before);
+    assert(c.allocations == 2);
+    assert(c.peak_bytes >= live_before + int64_t(6000 * sizeof(int)));
+    assert(memory_stats::allocation_report().find("DIMACS") != std::string::npos);
+    std::cout << "PASSED: test_counting_allocator\n";
+}
+
+int main() {
+    test_rss_readings();
+    test_phase_peaks();
+    test_counting_allocator();
+
+    std::cout << "\nAll memory stats tests passed!\n";
+    return 0;
+}
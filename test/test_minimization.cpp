@@ -0,0 +1,135 @@
+#include <iostream>
+#include <cassert>
+#include <random>
+#include "../src/variable_pattern.hpp"
+#include "../src/known_pattern.cpp"
+#include "../src/minimization.hpp"
+#include "../src/deepening.hpp"
+#include "../src/solution.hpp"
+#include "../src/cdcl.hpp"
+
+// Minimum count of true literals among variables 1..k over the models of a formula, -1 if none
+int brute_force_minimum(const std::vector<std::vector<int>>& formula, int n, int k) {
+    int best = -1;
+    for (uint32_t bits = 0; bits < (1u << n); bits++) {
+        bool sat = true;
+        for (const auto& clause : formula) {
+            bool any = false;
+            for (int lit : clause) any |= (((bits >> (std::abs(lit) - 1)) & 1) != 0) == (lit > 0);
+            sat &= any;
+        }
+        int count = __builtin_popcount(bits & ((1u << k) - 1));
+        if (sat && (best < 0 || count < best)) best = count;
+    }
+    return best;
+}
+
+void test_random_formulas() {
+    std::mt19937 rng(5);
+    const int n = 12, k = 8;
+    CellSum sum;
+    for (int v = 1; v <= k; v++) sum.literals.push_back(v);
+    sum.alive = 2;
+    int unsat = 0;
+    for (int round = 0; round < 60; round++) {
+        std::vector<std::vector<int>> formula;
+        std::uniform_int_distribution<int> var(1, n), sign(0, 1);
+        for (int i = 0; i < 40; i++) {
+            std::vector<int> clause;
+            for (int j = 0; j < 3; j++) clause.push_back(sign(rng) ? var(rng) : -var(rng));
+            formula.push_back(clause);
+        }
+        CdclSolver solver;
+        for (const auto& clause : formula) solver.add_clause(clause);
+        MinimizationResult result = minimize_population(solver, sum, n);
+        int expected = brute_force_minimum(formula, n, k);
+        if (expected < 0) {
+            assert(result.status == SolverStatus::UNSAT && result.solves == 1);
+            unsat++;
+            continue;
+        }
+        assert(result.status == SolverStatus::SAT && result.population == expected + sum.alive);
+        std::vector<bool> values = model_values(result.solution, n);
+        int count = 0;
+        for (int v = 1; v <= k; v++) count += values[v];
+        assert(count == expected);
+        // bounds were only assumed
+        assert(solver.solve() == SolverStatus::SAT);
+    }
+    assert(unsat > 0);
+    std::cout << "PASSED: test_random_formulas\n";
+}
+
+// Smallest still life and smallest period-2 oscillator in a 4x4 area: the block and the blinker
+void test_smallest_patterns() {
+    for (int period : {1, 2}) {
+        Bounds bounds({0, 5}, {0, 5}, {0, period});
+        VariablePattern pattern(bounds);
+        pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+        SearchProblem problem(bounds);
+        problem.add_entry(&pattern, [](Point) { return true; });
+        problem.build();
+
+        CdclSolver solver;
+        solver.add_clauses(problem.get_clauses());
+        solver.add_clauses(shifted_copy_constraints(problem, period, 0, 0));
+        solver.add_clause(generation_alive_clause(problem, 0));
+        if (period == 2) {
+            // not a still life: some cell changes in generation 1
+            BigClause changes;
+            int last_variable = problem.num_variables();
+            for (int y = 1; y <= 4; y++)
+                for (int x = 1; x <= 4; x++) {
+                    int a = problem.get_cell_value({x, y, 0}) - 1, b = problem.get_cell_value({x, y, 1}) - 1;
+                    int d = ++last_variable;  // d -> a != b
+                    solver.add_clause({-d, a, b});
+                    solver.add_clause({-d, -a, -b});
+                    changes.push_back(d);
+                }
+            solver.add_clause(changes);
+        }
+        int model_vars = problem.num_variables();
+        MinimizationResult result = minimize_population(solver, generation_sum(problem, 0), model_vars);
+        assert(result.status == SolverStatus::SAT);
+        assert(result.population == (period == 1 ? 4 : 3));
+
+        BitPlane gen0 = extract_generation(problem, result.solution, 0);
+        assert(gen0.population() == result.population);
+        BitPlane evolved = gen0;
+        for (int t = 0; t < period; t++) evolved = life_step(evolved);
+        for (int y = 0; y <= 5; y++)
+            for (int x = 0; x <= 5; x++) assert(evolved.get(x, y) == gen0.get(x, y));
+        std::cout << "  period " << period << ": population " << result.population << " after " << result.solves
+                  << " solves\n";
+    }
+    std::cout << "PASSED: test_smallest_patterns\n";
+}
+
+// Known live cells count, and assumptions restrict the search
+void test_known_cells_and_assumptions() {
+    CdclSolver solver;
+    solver.add_clause({1, 2, 3});
+    solver.add_clause({-1, 4});
+    CellSum sum;
+    sum.literals = {1, 2, 3, 4};
+    sum.alive = 3;
+    MinimizationResult result = minimize_population(solver, sum, 4);
+    assert(result.status == SolverStatus::SAT && result.population == 4);
+
+    result = minimize_population(solver, sum, 4, {-2, -3});
+    assert(result.status == SolverStatus::SAT && result.population == 5);  // 1 forces 4
+    assert(result.solution.solution.count(1) && result.solution.solution.count(4));
+
+    result = minimize_population(solver, sum, 4, {-1, -2, -3});
+    assert(result.status == SolverStatus::UNSAT && result.population == -1);
+    std::cout << "PASSED: test_known_cells_and_assumptions\n";
+}
+
+int main() {
+    test_random_formulas();
+    test_smallest_patterns();
+    test_known_cells_and_assumptions();
+
+    std::cout << "\nAll minimization tests passed!\n";
+    return 0;
+}
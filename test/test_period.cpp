@@ -0,0 +1,79 @@
+#include <cassert>
+#include <iostream>
+#include "../src/known_pattern.cpp"
+#include "../src/period.hpp"
+
+const std::string GLIDER = "bo$2bo$3o!";
+const std::string LWSS = "bo2bo$o4b$o3bo$4o!";
+
+// state(p) == state(T(p)) for every cell around the pattern whose image is still evolved
+void assert_symmetry(const KnownPattern& pattern, const AffineTransf& transf) {
+    auto [xlims, ylims, tlims] = pattern.get_bounds();
+    for (int t = tlims.first; t + std::get<6>(transf) <= tlims.second; t++)
+        for (int y = ylims.first - 2; y <= ylims.second + 2; y++)
+            for (int x = xlims.first - 2; x <= xlims.second + 2; x++)
+                assert(pattern.get_state({x, y, t}) == pattern.get_state(transform(transf, {x, y, t})));
+}
+
+void test_still_life_and_oscillator() {
+    PeriodInfo block = detect_period(parse_rle("2o$2o!"), 10);
+    assert(block.found && block.period == 1 && !block.moves());
+
+    PeriodInfo blinker = detect_period(parse_rle("3o!"), 10);
+    assert(blinker.found && blinker.period == 2 && !blinker.moves() && !blinker.glides());
+    // up to orientation, each phase is a rotation of the previous one
+    PeriodInfo rotated = detect_period(parse_rle("3o!"), 10, true);
+    assert(rotated.found && rotated.period == 2 && rotated.glide_period == 1 && rotated.glide_orientation != 0);
+    KnownPattern pattern("3o!", 8);
+    assert_symmetry(pattern, rotated.transf());
+    assert_symmetry(pattern, rotated.glide_transf());
+    std::cout << "PASSED: test_still_life_and_oscillator\n";
+}
+
+void test_spaceships() {
+    PeriodInfo glider = detect_period(parse_rle(GLIDER), 10);
+    assert(glider.found && glider.period == 4 && glider.dx == 1 && glider.dy == 1);
+    assert(glider.transf() == AffineTransf(1, 0, 0, 1, 1, 1, 4));
+
+    // the LWSS is its own mirror image, shifted, every 2 generations
+    PeriodInfo lwss = detect_period(parse_rle(LWSS), 10);
+    assert(lwss.found && lwss.period == 4 && lwss.dx == -2 && lwss.dy == 0);
+    assert(!lwss.glides());
+    // one pass gives both the period and the glide
+    PeriodInfo glide = detect_period(parse_rle(LWSS), 10, true);
+    assert(glide.found && glide.period == 4 && glide.dx == -2 && glide.dy == 0);
+    assert(glide.glide_period == 2 && glide.glide_orientation == 5 && glide.glide_dx == -1 && glide.glide_dy == 4);
+    assert(glide.glide_transf() == AffineTransf(1, 0, 0, -1, -1, 4, 2));
+
+    KnownPattern pattern(LWSS, 12);
+    pattern.shift_by({7, -3, 0});
+    PeriodInfo shifted = detect_period(pattern, true);
+    assert(shifted.period == 4 && shifted.glide_period == 2 && shifted.glide_orientation == 5);
+    assert_symmetry(pattern, shifted.transf());
+    assert_symmetry(pattern, shifted.glide_transf());
+    PeriodInfo glider_glide = detect_period(KnownPattern(GLIDER, 12), true);
+    assert(glider_glide.period == 4 && glider_glide.glide_period == 2);
+    assert_symmetry(KnownPattern(GLIDER, 12), glider_glide.glide_transf());
+    std::cout << "PASSED: test_spaceships\n";
+}
+
+void test_no_period() {
+    // a pre-block that becomes a block: gen 0 never reappears
+    PeriodInfo preblock = detect_period(parse_rle("2o$bo!"), 20);
+    assert(!preblock.found);
+    std::vector<BitPlane> phases;
+    PeriodInfo dies = detect_period(parse_rle("o!"), 20, false, &phases);
+    assert(!dies.found && phases.back().width == 0);
+    // too short to see the glider repeat
+    assert(!detect_period(KnownPattern(GLIDER, 3)).found);
+    std::cout << "PASSED: test_no_period\n";
+}
+
+int main() {
+    test_still_life_and_oscillator();
+    test_spaceships();
+    test_no_period();
+
+    std::cout << "\nAll period detection tests passed!\n";
+    return 0;
+}
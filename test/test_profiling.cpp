@@ -0,0 +1,137 @@
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../src/profiling.hpp"
+
+size_t occurrences(const std::string& text, const std::string& pattern) {
+    size_t n = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) n++;
+    return n;
+}
+
+std::string trace_json() {
+    std::ostringstream oss;
+    profiling::write_chrome_trace(oss);
+    return oss.str();
+}
+
+void test_disabled_records_nothing() {
+    profiling::reset();
+    profiling::enable(false);
+    {
+        profiling::ScopedTimer timer("ignored");
+        profiling::count("ignored counter", 5);
+    }
+    assert(occurrences(trace_json(), "\"ph\"") == 0);
+    assert(profiling::counter_total("ignored counter") == 0);
+    std::cout << "PASSED: test_disabled_records_nothing\n";
+}
+
+void test_nesting_and_counters() {
+    profiling::reset();
+    profiling::enable();
+    {
+        profiling::ScopedTimer outer("outer");
+        for (int i = 0; i < 3; i++) {
+            profiling::ScopedTimer inner("inner");
+            profiling::count("items", 2);
+        }
+        profiling::ScopedTimer early("early");
+        early.stop();
+        early.stop();  // stopping twice records once
+    }
+    profiling::enable(false);
+
+    std::string json = trace_json();
+    assert(json.rfind("{\"traceEvents\":[", 0) == 0);
+    assert(occurrences(json, "\"ph\":\"X\"") == 5);
+    assert(occurrences(json, "\"ph\":\"C\"") == 3);
+    assert(occurrences(json, "\"path\":\"outer/inner\"") == 3);
+    assert(occurrences(json, "\"path\":\"outer/early\"") == 1);
+    assert(profiling::counter_total("items") == 6);
+
+    std::string text = profiling::summary();
+    size_t outer_line = text.find("\nouter ");
+    size_t inner_line = text.find("\n  inner ");
+    assert(outer_line != std::string::npos && inner_line != std::string::npos && outer_line < inner_line);
+    assert(text.find("items") != std::string::npos);
+    std::cout << "PASSED: test_nesting_and_counters\n";
+}
+
+void test_threads_record_separately() {
+    profiling::reset();
+    profiling::enable();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([] {
+            for (int j = 0; j < 100; j++) {
+                profiling::ScopedTimer timer("work");
+                profiling::count("steps");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    profiling::enable(false);
+
+    std::string json = trace_json();
+    assert(occurrences(json, "\"name\":\"work\"") == 400);
+    for (int tid = 1; tid <= 4; tid++)
+        assert(occurrences(json, "\"tid\":" + std::to_string(tid) + ",") > 0);
+    assert(profiling::counter_total("steps") == 400);
+    profiling::reset();
+    std::cout << "PASSED: test_threads_record_separately\n";
+}
+
+void test_hardware_counters() {
+    using namespace perf_counters;
+    Sample a, b;
+    a.values = {100, 300, 5, 7};
+    a.valid = (1u << CYCLES) | (1u << INSTRUCTIONS) | (1u << BRANCH_MISSES);
+    b.values = {40, 60, 1, 2};
+    b.valid = (1u << CYCLES) | (1u << INSTRUCTIONS);
+    Sample d = a - b;
+    assert(d.has(CYCLES) && !d.has(BRANCH_MISSES) && d.values[INSTRUCTIONS] == 240);
+    assert(d.ipc() == 4.0);
+    assert((a + Sample()).values == a.values && (a - Sample()).valid == a.valid);
+
+    enable(false);
+    assert(read().empty());
+
+    profiling::reset();
+    profiling::enable();
+    enable();
+    bool hardware = available();
+    volatile uint64_t sum = 0;
+    {
+        profiling::ScopedTimer timer("work");
+        for (int i = 0; i < 1000000; i++) sum = sum + i;
+    }
+    enable(false);
+    profiling::enable(false);
+
+    Sample used = profiling::timer_counters("work");
+    if (hardware) {
+        assert(used.has(INSTRUCTIONS) && used.values[INSTRUCTIONS] > 1000000);
+        assert(profiling::summary().find("IPC") != std::string::npos);
+        assert(trace_json().find("\"instructions\":") != std::string::npos);
+    } else {
+        // unavailable counters leave the timers as they were
+        assert(used.empty());
+        assert(profiling::summary().find("IPC") == std::string::npos);
+    }
+    assert(profiling::timer_total_ns("work") > 0);
+    profiling::reset();
+    std::cout << "PASSED: test_hardware_counters" << (hardware ? "" : " (counters unavailable)") << "\n";
+}
+
+int main() {
+    test_disabled_records_nothing();
+    test_nesting_and_counters();
+    test_threads_record_separately();
+    test_hardware_counters();
+
+    std::cout << "\nAll profiling tests passed!\n";
+    return 0;
+}
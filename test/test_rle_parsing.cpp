@@ -1,6 +1,10 @@
 #include <cassert>
 #include <iostream>
+#include <random>
+#include <cstdio>
 #include "../src/known_pattern.cpp"
+#include "../src/variable_pattern.hpp"
+#include "../src/solution.hpp"
 
 // Test that headers (lines starting with 'x') are skipped
 void test_skips_header() {
@@ -47,10 +51,78 @@ void test_skips_header_and_comments() {
     std::cout << "PASSED: test_skips_header_and_comments\n";
 }
 
+// The header size is used for the plane; the rule must be Life
+void test_header_and_rule() {
+    RleHeader header;
+    BitPlane plane = parse_rle("x = 100, y = 7, rule = B3/S23\n3o!", &header);
+    assert(header.width == 100 && header.height == 7 && header.rule == "B3/S23");
+    assert(plane.width == 100 && plane.height == 7);
+    assert(plane.get(2, 0) && !plane.get(3, 0));
+
+    bool threw = false;
+    try {
+        parse_rle("x = 3, y = 1, rule = B36/S23\n3o!");
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "PASSED: test_header_and_rule\n";
+}
+
+// Writing then reading a plane (through a memory-mapped file) gives back the same cells
+void test_write_read_round_trip() {
+    std::mt19937 rng(7);
+    BitPlane soup(0, 0, 200, 30);
+    for (int y = 0; y < 30; y++)
+        for (int x = 0; x < 200; x++)
+            if (y != 12 && rng() % 4 == 0) soup.set(x, y, true);  // row 12 left empty
+    for (int x = 64; x < 192; x++) soup.set(x, 3, true);        // runs spanning whole words
+
+    char filename[] = "/tmp/test_rle_XXXXXX";
+    int fd = mkstemp(filename);
+    close(fd);
+    write_rle_file(soup, filename, true);
+    BitPlane read = read_rle_file(filename);
+    std::remove(filename);
+
+    assert(read.trimmed() == soup.trimmed());
+    assert(parse_rle(plane_to_rle(soup)).trimmed() == soup.trimmed());
+    assert(plane_to_rle(parse_rle("2o$2o!")) == "x = 2, y = 2, rule = B3/S23\n2o$2o!\n");
+
+    // any generation of a known pattern
+    KnownPattern glider("bo$2bo$3o!", 4);
+    assert(plane_to_rle(glider.get_generation(2)) == "x = 3, y = 3, rule = B3/S23\n2bo$obo$b2o!\n");
+
+    std::cout << "PASSED: test_write_read_round_trip\n";
+}
+
+// A solved SearchProblem generation can be extracted and written as RLE
+void test_solution_rle() {
+    VariablePattern pattern(3, 1, 0);
+    pattern.build();
+    SearchProblem problem(3, 1, 0);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.build();
+
+    SolverResult result;
+    result.status = SolverStatus::SAT;
+    for (int x = 0; x < 3; x++) {
+        int var = problem.get_cell_value({x, 0, 0}) - 1;
+        result.solution.insert(x == 1 ? -var : var);
+    }
+    assert(plane_to_rle(extract_generation(problem, result, 0)) == "x = 3, y = 1, rule = B3/S23\nobo!\n");
+
+    std::cout << "PASSED: test_solution_rle\n";
+}
+
 int main() {
     test_skips_header();
     test_skips_comments();
     test_skips_header_and_comments();
+    test_header_and_rule();
+    test_write_read_round_trip();
+    test_solution_rle();
 
     std::cout << "\nAll RLE parsing tests passed!\n";
     return 0;
@@ -0,0 +1,115 @@
+#include <cassert>
+#include <iostream>
+#include <cstdlib>
+#include "../src/variable_pattern.hpp"
+#include "../src/verify.hpp"
+
+// A width x height search box over gens 0..max_gen with a dead border, wrapped in a SearchProblem
+struct BoxProblem {
+    VariablePattern pattern;
+    SearchProblem problem;
+
+    BoxProblem(int width, int height, int max_gen)
+        : pattern(width, height, max_gen), problem(width, height, max_gen) {
+        pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+        problem.add_entry(&pattern, [](Point) { return true; });
+        problem.build();
+    }
+};
+
+// Model in which exactly the given cells are alive (generations not listed are all dead)
+std::vector<bool> model_from_cells(const SearchProblem& problem, const std::set<Point>& alive) {
+    std::vector<bool> values(problem.num_variables() + 1, false);
+    for (Point p : alive) {
+        int var_idx = problem.get_cell_value(p);
+        if (var_idx >= 2) values[var_idx - 1] = true;
+    }
+    return values;
+}
+
+std::set<Point> blinker_history(int max_gen) {
+    std::set<Point> cells;
+    for (int t = 0; t <= max_gen; t++) {
+        for (int d = -1; d <= 1; d++) {
+            if (t % 2 == 0) cells.insert({3, 3 + d, t});
+            else cells.insert({3 + d, 3, t});
+        }
+    }
+    return cells;
+}
+
+const AffineTransf PERIOD_1 = {1, 0, 0, 1, 0, 0, 1};
+const AffineTransf PERIOD_2 = {1, 0, 0, 1, 0, 0, 2};
+
+void test_valid_model() {
+    BoxProblem box(7, 7, 4);
+    auto values = model_from_cells(box.problem, blinker_history(4));
+    VerifyResult result = verify_model(box.problem, values, {{PERIOD_2, nullptr}});
+    assert(result.valid);
+    assert(result.error.empty());
+    std::cout << "PASSED: test_valid_model\n";
+}
+
+void test_constraint_violation() {
+    BoxProblem box(7, 7, 4);
+    auto values = model_from_cells(box.problem, blinker_history(4));
+    VerifyResult result = verify_model(box.problem, values, {{PERIOD_1, nullptr}});
+    assert(!result.valid);
+    assert(result.error.find("constraint violated") != std::string::npos);
+    // a mask that excludes every cell the blinker changes makes it hold again
+    auto outside = [](Point p) { auto [x, y, t] = p; return std::abs(x - 3) + std::abs(y - 3) > 1; };
+    assert(verify_model(box.problem, values, {{PERIOD_1, outside}}).valid);
+    std::cout << "PASSED: test_constraint_violation\n";
+}
+
+void test_rule_violation() {
+    BoxProblem box(7, 7, 4);
+    auto values = model_from_cells(box.problem, blinker_history(4));
+    int var_idx = box.problem.get_cell_value({2, 3, 3});
+    assert(var_idx >= 2);
+    values[var_idx - 1] = !values[var_idx - 1];
+    VerifyResult result = verify_model(box.problem, values);
+    assert(!result.valid);
+    assert(result.error.find("rule violated") != std::string::npos);
+    std::cout << "PASSED: test_rule_violation\n";
+}
+
+// Only generation 0 is used: a glider must reappear shifted by (1, 1) after 4 generations
+void test_generation_zero() {
+    BoxProblem box(12, 12, 8);
+    std::set<Point> glider = {{2, 1, 0}, {3, 2, 0}, {1, 3, 0}, {2, 3, 0}, {3, 3, 0}};
+    auto values = model_from_cells(box.problem, glider);
+    AffineTransf glide = {1, 0, 0, 1, 1, 1, 4};
+    assert(verify_model(box.problem, values, {{glide, nullptr}}, VerifyMode::GENERATION_ZERO).valid);
+    assert(!verify_model(box.problem, values, {{PERIOD_2, nullptr}}, VerifyMode::GENERATION_ZERO).valid);
+    // the later generations of this model are all dead, so the stepwise check rejects it
+    assert(!verify_model(box.problem, values).valid);
+    std::cout << "PASSED: test_generation_zero\n";
+}
+
+void test_batch_in_parallel() {
+    BoxProblem box(7, 7, 4);
+    auto valid = model_from_cells(box.problem, blinker_history(4));
+    auto invalid = valid;
+    int var_idx = box.problem.get_cell_value({3, 2, 1});
+    invalid[var_idx - 1] = !invalid[var_idx - 1];
+
+    std::vector<std::vector<bool>> models;
+    for (int i = 0; i < 64; i++) models.push_back(i % 3 == 0 ? invalid : valid);
+    auto results = verify_models(box.problem, models, {{PERIOD_2, nullptr}}, VerifyMode::ALL_GENERATIONS, 4);
+    assert(results.size() == models.size());
+    for (size_t i = 0; i < results.size(); i++)
+        assert(results[i].valid == (i % 3 != 0));
+    std::cout << "PASSED: test_batch_in_parallel\n";
+}
+
+int main() {
+    test_valid_model();
+    test_constraint_violation();
+    test_rule_violation();
+    test_generation_zero();
+    test_batch_in_parallel();
+
+    std::cout << "\nAll verification tests passed!\n";
+    return 0;
+}
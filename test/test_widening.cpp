@@ -0,0 +1,156 @@
+#include <iostream>
+#include <cassert>
+#include "../src/variable_pattern.hpp"
+#include "../src/known_pattern.cpp"
+#include "../src/widening.hpp"
+#include "../src/deepening.hpp"
+#include "../src/solution.hpp"
+#include "../src/cdcl.hpp"
+
+// A glider's four phases span a 4x4 box: the 2x2 start box is refuted, the next one is enough
+void test_glider_box() {
+    Bounds bounds({0, 8}, {0, 8}, {0, 4});
+    VariablePattern pattern(bounds);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(bounds);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.set_deduplicate(false);
+    problem.build();
+
+    CdclSolver solver;
+    solver.add_clause(generation_alive_clause(problem, 0));
+    solver.add_clauses(shifted_copy_constraints(problem, 4, 1, 1));
+    WideningResult found = iterative_widening(problem, solver, {4, 5}, {4, 5});
+    assert(found.status == SolverStatus::SAT);
+    assert(found.steps == 2 && solver.stats().solves == 2);
+    assert((found.xlims == Limits{3, 6} && found.ylims == Limits{3, 6}));
+
+    BitPlane evolved = extract_generation(problem, found.solution, 0);
+    for (int t = 0; t <= 4; t++) {
+        BitPlane gen = extract_generation(problem, found.solution, t);
+        for (int y = 0; y <= 8; y++)
+            for (int x = 0; x <= 8; x++) {
+                assert(evolved.get(x, y) == gen.get(x, y));
+                if (gen.get(x, y)) assert(in_limits(Point(x, y, t), {found.xlims, found.ylims, {0, 4}}));
+            }
+        evolved = life_step(evolved);
+    }
+    std::cout << "PASSED: test_glider_box (" << solver.stats().conflicts << " conflicts)\n";
+}
+
+// A birth from an all-dead neighborhood is refuted by the transitions inside the box alone, so the
+// driver stops after the first box
+void test_stops_without_dead_outside() {
+    Bounds bounds({0, 6}, {0, 6}, {0, 2});
+    VariablePattern pattern(bounds);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(bounds);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.set_deduplicate(false);
+    problem.build();
+
+    CdclSolver solver;
+    for (int y = 2; y <= 4; y++)
+        for (int x = 2; x <= 4; x++) solver.add_clause({-(problem.get_cell_value({x, y, 0}) - 1)});
+    solver.add_clause({problem.get_cell_value({3, 3, 1}) - 1});
+    WideningResult found = iterative_widening(problem, solver, {3, 3}, {3, 3});
+    assert(found.status == SolverStatus::UNSAT);
+    assert(found.steps == 1);
+    std::cout << "PASSED: test_stops_without_dead_outside\n";
+}
+
+// Growing by two cells per side reaches the bounds, where nothing is forced dead any more
+void test_step_and_checks() {
+    Bounds bounds({0, 5}, {0, 5}, {0, 2});
+    VariablePattern pattern(bounds);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(bounds);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.build();
+
+    CdclSolver solver;
+    bool refused = false;
+    try {
+        iterative_widening(problem, solver, {2, 3}, {2, 3});
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    assert(refused);
+
+    problem.set_deduplicate(false);
+    problem.build();
+    // five live cells in generation 0 do not fit a 2x2 box
+    BigClauseList units;
+    for (int x = 1; x <= 4; x++) units.push_back({problem.get_cell_value({x, 1, 0}) - 1});
+    units.push_back({problem.get_cell_value({1, 2, 0}) - 1});
+    solver.add_clauses(units);
+    WideningResult found = iterative_widening(problem, solver, {2, 3}, {2, 3}, 2);
+    assert(found.steps == 2);
+    assert((found.xlims == Limits{0, 5} && found.ylims == Limits{0, 5}));
+
+    // the last box is the whole problem
+    CdclSolver scratch;
+    scratch.add_clauses(problem.get_clauses());
+    scratch.add_clauses(units);
+    assert(scratch.solve() == found.status);
+    std::cout << "PASSED: test_step_and_checks (" << solver_status_name(found.status) << ")\n";
+}
+
+// Reports every assumption as failed, as IPASIR allows for assumptions a refutation did not use,
+// and counts the clauses over variables above `watched_above` (the widening's own literals)
+class PessimisticSolver : public CdclSolver {
+    public:
+        int watched_above = INT_MAX;
+        size_t watched = 0;
+
+        using CdclSolver::add_clause;
+        void add_clause(const std::vector<int>& literals) override {
+            for (int lit : literals)
+                if (std::abs(lit) > watched_above) {
+                    watched++;
+                    break;
+                }
+            CdclSolver::add_clause(literals);
+        }
+        bool failed(int) const override { return true; }
+};
+
+// An unsatisfiable problem ends at the bounds even when every box looks needed, and each free
+// cell outside the start box is forced dead once, not once per box
+void test_stops_at_bounds() {
+    Bounds bounds({0, 6}, {0, 6}, {0, 2});
+    VariablePattern pattern(bounds);
+    pattern.set_known_if(false, [&](const Cell& c) { return pattern.is_boundary(c.position); });
+    SearchProblem problem(bounds);
+    problem.add_entry(&pattern, [](Point) { return true; });
+    problem.set_deduplicate(false);
+    problem.build();
+    int center = problem.get_cell_value({3, 3, 0}) - 1;
+
+    PessimisticSolver full;
+    full.add_clause({center});
+    full.add_clause({-center});
+    WideningResult found = iterative_widening(problem, full, {0, 6}, {0, 6});
+    assert(found.status == SolverStatus::UNSAT && found.steps == 1);
+
+    PessimisticSolver growing;
+    growing.add_clause({center});
+    growing.add_clause({-center});
+    growing.watched_above = problem.num_variables();
+    found = iterative_widening(problem, growing, {3, 3}, {3, 3});
+    assert(found.status == SolverStatus::UNSAT && found.steps == 4);
+    assert((found.xlims == Limits{0, 6} && found.ylims == Limits{0, 6}));
+    // 24 free cells per generation outside the start box, plus a chain and a release clause per box
+    assert(growing.watched <= 24 * 3 + 2 * 4);
+    std::cout << "PASSED: test_stops_at_bounds\n";
+}
+
+int main() {
+    test_glider_box();
+    test_stops_without_dead_outside();
+    test_step_and_checks();
+    test_stops_at_bounds();
+
+    std::cout << "\nAll widening tests passed!\n";
+    return 0;
+}